@@ -0,0 +1,373 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "awgn_channel.hpp"
+#include "bpsk.hpp"
+#include "bpsk_passband.hpp"
+#include "chase_algorithm.hpp"
+#include "hamming_decoder.hpp"
+#include "hamming_encoder.hpp"
+#include "soft_metric.hpp"
+#include "utils.hpp"
+
+namespace {
+
+// Диапазоны параметров: r кода, d алгоритма Чейза, длина блока в символах.
+constexpr int kMinR = 3;
+constexpr int kMaxR = 8;
+
+std::vector<uint8_t> RandomBits(std::size_t size, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<uint8_t> bits(size);
+  for (auto& bit : bits) {
+    bit = coin(rng) ? 1 : 0;
+  }
+  return bits;
+}
+
+std::vector<double> RandomLlr(std::size_t size, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(1.0, 1.0);
+  std::vector<double> values(size);
+  for (double& value : values) {
+    value = noise(rng);
+  }
+  return values;
+}
+
+// Счётчики пропускной способности: bits — информационных битов на
+// итерацию, frames — кадров (кодовых слов, блоков) на итерацию.
+void SetThroughput(benchmark::State& state, int64_t bits, int64_t frames = 1) {
+  const double iterations = static_cast<double>(state.iterations());
+  state.counters["bits/s"] = benchmark::Counter(
+      iterations * static_cast<double>(bits), benchmark::Counter::kIsRate);
+  state.counters["frames/s"] = benchmark::Counter(
+      iterations * static_cast<double>(frames), benchmark::Counter::kIsRate);
+}
+
+void BM_HammingEncode(benchmark::State& state) {
+  const harq::HammingEncoder encoder(static_cast<int>(state.range(0)));
+  const auto data = RandomBits(encoder.k(), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(encoder.Encode(data));
+  }
+  SetThroughput(state, encoder.k());
+}
+BENCHMARK(BM_HammingEncode)->DenseRange(kMinR, kMaxR);
+
+void BM_HammingEncodePacked(benchmark::State& state) {
+  const harq::HammingEncoder encoder(static_cast<int>(state.range(0)));
+  const harq::BitVector data(RandomBits(encoder.k(), 1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(encoder.Encode(data));
+  }
+  SetThroughput(state, encoder.k());
+}
+BENCHMARK(BM_HammingEncodePacked)->DenseRange(kMinR, kMaxR);
+
+// Принятое слово с одной ошибкой: декодер проходит путь исправления.
+std::vector<uint8_t> ReceivedWord(int r) {
+  const harq::HammingEncoder encoder(r);
+  auto codeword = encoder.EncodeExtended(RandomBits(encoder.k(), 2));
+  codeword[codeword.size() / 3] ^= 1;
+  return codeword;
+}
+
+void BM_HammingDecode(benchmark::State& state) {
+  const int r = static_cast<int>(state.range(0));
+  const harq::HammingDecoder decoder(r);
+  const auto codeword = ReceivedWord(r);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(decoder.Decode(codeword));
+  }
+  SetThroughput(state, decoder.k());
+}
+BENCHMARK(BM_HammingDecode)->DenseRange(kMinR, kMaxR);
+
+void BM_HammingDecodeWithStatus(benchmark::State& state) {
+  const int r = static_cast<int>(state.range(0));
+  const harq::HammingDecoder decoder(r);
+  const auto codeword = ReceivedWord(r);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(decoder.DecodeWithStatus(codeword));
+  }
+  SetThroughput(state, decoder.k());
+}
+BENCHMARK(BM_HammingDecodeWithStatus)->DenseRange(kMinR, kMaxR);
+
+void BM_BpskMap(benchmark::State& state) {
+  const auto bits = RandomBits(static_cast<std::size_t>(state.range(0)), 3);
+  std::vector<double> symbols(bits.size());
+  for (auto _ : state) {
+    harq::BpskMap(bits, symbols);
+    benchmark::ClobberMemory();
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_BpskMap)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+void BM_BpskMapPacked(benchmark::State& state) {
+  const harq::BitVector bits(
+      RandomBits(static_cast<std::size_t>(state.range(0)), 3));
+  std::vector<double> symbols(bits.size());
+  for (auto _ : state) {
+    harq::BpskMapPacked(bits.words(), symbols);
+    benchmark::ClobberMemory();
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_BpskMapPacked)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+void BM_BpskDemapPacked(benchmark::State& state) {
+  const auto symbols = RandomLlr(static_cast<std::size_t>(state.range(0)), 4);
+  std::vector<uint64_t> words((symbols.size() + 63) / 64);
+  for (auto _ : state) {
+    harq::BpskDemapPacked(symbols, words);
+    benchmark::ClobberMemory();
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_BpskDemapPacked)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+void BM_AwgnAddNoise(benchmark::State& state) {
+  harq::AwgnChannel channel(3.0, 7);
+  const auto symbols =
+      harq::BpskModulate(RandomBits(static_cast<std::size_t>(state.range(0)), 3));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(channel.AddNoise(symbols));
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_AwgnAddNoise)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+void BM_AwgnAddNoiseInPlace(benchmark::State& state) {
+  harq::AwgnChannel channel(3.0, 7);
+  auto symbols =
+      harq::BpskModulate(RandomBits(static_cast<std::size_t>(state.range(0)), 3));
+  for (auto _ : state) {
+    channel.AddNoiseInPlace(symbols);
+    benchmark::ClobberMemory();
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_AwgnAddNoiseInPlace)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+void BM_AwgnComputeLlr(benchmark::State& state) {
+  const harq::AwgnChannel channel(3.0, 7);
+  const auto received = RandomLlr(static_cast<std::size_t>(state.range(0)), 4);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(channel.ComputeLlr(received));
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_AwgnComputeLlr)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+// Аргументы: длина слова, число выбираемых позиций.
+void BM_GetNSmallestIndices(benchmark::State& state) {
+  const auto values = RandomLlr(static_cast<std::size_t>(state.range(0)), 5);
+  const int count = static_cast<int>(state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(harq::get_n_smallest_indices(values, count));
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_GetNSmallestIndices)
+    ->ArgsProduct({{15, 63, 255}, {1, 3, 8}})
+    ->Args({255, 64})
+    ->Args({255, 100});
+
+// Аргументы пробных последовательностей и кандидатов: r, d.
+void ProbeArgs(benchmark::internal::Benchmark* bench) {
+  for (int r : {3, 4, 5, 6}) {
+    for (int d : {2, 3, 4}) {
+      bench->Args({r, d});
+    }
+  }
+}
+
+void BM_GenerateProbeSequences1(benchmark::State& state) {
+  const int n = (1 << state.range(0)) - 1;
+  const int d = static_cast<int>(state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(harq::generate_probe_sequences_1(n, d));
+  }
+  SetThroughput(state, n);
+}
+BENCHMARK(BM_GenerateProbeSequences1)->Apply(ProbeArgs);
+
+void BM_GenerateProbeSequences2(benchmark::State& state) {
+  const int n = (1 << state.range(0)) - 1;
+  const int d = static_cast<int>(state.range(1));
+  const auto reliability = RandomLlr(n, 6);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        harq::generate_probe_sequences_2(n, d, reliability));
+  }
+  SetThroughput(state, n);
+}
+BENCHMARK(BM_GenerateProbeSequences2)->Apply(ProbeArgs);
+
+void BM_GenerateProbeSequences3(benchmark::State& state) {
+  const int n = (1 << state.range(0)) - 1;
+  const int d = static_cast<int>(state.range(1));
+  const auto reliability = RandomLlr(n, 6);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        harq::generate_probe_sequences_3(n, d, reliability));
+  }
+  SetThroughput(state, n);
+}
+BENCHMARK(BM_GenerateProbeSequences3)->Apply(ProbeArgs);
+
+void BM_CalculateCandidates(benchmark::State& state) {
+  const int r = static_cast<int>(state.range(0));
+  const int d = static_cast<int>(state.range(1));
+  const auto algorithm = static_cast<harq::ProbeAlgorithm>(state.range(2));
+  const int n = (1 << r) - 1;
+  const int k = n - r;
+  const auto reliability = RandomLlr(n, 8);
+  const auto message = harq::BpskDemodulate(reliability);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        harq::CalculateCandidates(message, r, d, reliability, algorithm));
+  }
+  SetThroughput(state, k);
+}
+BENCHMARK(BM_CalculateCandidates)
+    ->ArgsProduct({{3, 4, 5, 6}, {2, 4}, {0, 1, 2, 3}});
+
+void BM_CalculateCandidatesPacked(benchmark::State& state) {
+  const int r = static_cast<int>(state.range(0));
+  const int d = static_cast<int>(state.range(1));
+  const auto algorithm = static_cast<harq::ProbeAlgorithm>(state.range(2));
+  const int n = (1 << r) - 1;
+  const int k = n - r;
+  const auto reliability = RandomLlr(n, 8);
+  const harq::BitVector message(harq::BpskDemodulate(reliability));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        harq::CalculateCandidates(message, r, d, reliability, algorithm));
+  }
+  SetThroughput(state, k);
+}
+BENCHMARK(BM_CalculateCandidatesPacked)
+    ->ArgsProduct({{3, 4, 5, 6}, {2, 4}, {0, 1, 2, 3}});
+
+// Метрика списка кандидатов Chase-II: аргументы r, d, SimdLevel. LLR типа
+// T — гауссовы значения, для целых типов масштабированные в [-127, 127];
+// метрика накапливается в Acc.
+template <typename T, typename Acc>
+void BM_ScoreCandidates(benchmark::State& state) {
+  const int r = static_cast<int>(state.range(0));
+  const int d = static_cast<int>(state.range(1));
+  const auto level = static_cast<harq::SimdLevel>(state.range(2));
+  const int n = (1 << r) - 1;
+  const auto reliability = RandomLlr(n, 10);
+  const auto candidates = harq::CalculateCandidates(
+      harq::BpskDemodulate(reliability), r, d, reliability,
+      harq::ProbeAlgorithm::Second);
+
+  std::vector<T> llr(n);
+  for (int i = 0; i < n; i++) {
+    if constexpr (std::is_floating_point_v<T>) {
+      llr[i] = static_cast<T>(reliability[i]);
+    } else {
+      llr[i] = static_cast<T>(
+          std::clamp(std::lround(reliability[i] * 32.0), -127L, 127L));
+    }
+  }
+  std::vector<uint8_t> rows;
+  rows.reserve(candidates.size() * n);
+  for (const auto& candidate : candidates) {
+    rows.insert(rows.end(), candidate.begin(), candidate.end());
+  }
+  std::vector<Acc> metrics(candidates.size());
+
+  for (auto _ : state) {
+    harq::ScoreCandidates(std::span<const T>(llr),
+                          std::span<const uint8_t>(rows),
+                          std::span<Acc>(metrics), level);
+    benchmark::ClobberMemory();
+  }
+  SetThroughput(state, n - r, static_cast<int64_t>(candidates.size()));
+}
+
+void ScoreArgs(benchmark::internal::Benchmark* bench) {
+  bench->ArgsProduct({{4, 6}, {4, 8},
+                      {static_cast<int64_t>(harq::SimdLevel::kScalar),
+                       static_cast<int64_t>(harq::SimdLevel::kAvx2)}});
+}
+
+BENCHMARK_TEMPLATE(BM_ScoreCandidates, double, double)->Apply(ScoreArgs);
+BENCHMARK_TEMPLATE(BM_ScoreCandidates, float, float)->Apply(ScoreArgs);
+BENCHMARK_TEMPLATE(BM_ScoreCandidates, int16_t, int32_t)->Apply(ScoreArgs);
+BENCHMARK_TEMPLATE(BM_ScoreCandidates, int8_t, int32_t)->Apply(ScoreArgs);
+
+// Аргументы несущей: число битов блока, отсчётов на символ.
+harq::BpskCarrierConfig CarrierConfig(benchmark::State& state) {
+  harq::BpskCarrierConfig config;
+  config.samples_per_symbol = static_cast<int>(state.range(1));
+  config.sample_rate_hz = 8000.0 * config.samples_per_symbol;
+  config.carrier_hz = 2000.0;
+  return config;
+}
+
+void BM_BpskPassbandModulate(benchmark::State& state) {
+  const auto config = CarrierConfig(state);
+  const auto bits = RandomBits(static_cast<std::size_t>(state.range(0)), 9);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(harq::BpskPassbandModulate(bits, config));
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_BpskPassbandModulate)->ArgsProduct({{64, 1024, 8192}, {4, 16}});
+
+void BM_BpskPassbandDemodulate(benchmark::State& state) {
+  const auto config = CarrierConfig(state);
+  const auto samples = harq::BpskPassbandModulate(
+      RandomBits(static_cast<std::size_t>(state.range(0)), 9), config);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(harq::BpskPassbandDemodulate(samples, config));
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_BpskPassbandDemodulate)
+    ->ArgsProduct({{64, 1024, 8192}, {4, 16}});
+
+void BM_BpskPassbandSoftDemodulate(benchmark::State& state) {
+  const auto config = CarrierConfig(state);
+  const auto samples = harq::BpskPassbandModulate(
+      RandomBits(static_cast<std::size_t>(state.range(0)), 9), config);
+  harq::BpskPassbandSoftDemodulator demodulator(config);
+  std::vector<double> llr(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    demodulator.Reset();
+    benchmark::DoNotOptimize(demodulator.Process(samples, llr));
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_BpskPassbandSoftDemodulate)
+    ->ArgsProduct({{64, 1024, 8192}, {4, 16}});
+
+void BM_PassbandAwgnAddNoise(benchmark::State& state) {
+  const auto config = CarrierConfig(state);
+  harq::PassbandAwgnChannel channel(6.0, config, 7);
+  auto samples = harq::BpskPassbandModulate(
+      RandomBits(static_cast<std::size_t>(state.range(0)), 9), config);
+  for (auto _ : state) {
+    channel.AddNoiseInPlace(samples);
+    benchmark::ClobberMemory();
+  }
+  SetThroughput(state, state.range(0));
+}
+BENCHMARK(BM_PassbandAwgnAddNoise)->ArgsProduct({{1024, 8192, 65536}, {4, 16}});
+
+}  // namespace
@@ -0,0 +1,328 @@
+// Сквозной бенчмарк линии: кодер -> BPSK -> АБГШ -> LLR -> объединение
+// HARQ -> декодер Чейза при фиксированном SNR. Каждый поток гоняет
+// frames кадров на своём наборе объектов; отчёт — декодированные Мбит/с
+// всего и на ядро для 1..threads потоков и доля времени каждой стадии.
+//
+//   link_bench --r=6 --d=4 --snr=2 --rounds=4 --frames=20000 --threads=8
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "awgn_channel.hpp"
+#include "bit_packing.hpp"
+#include "bpsk.hpp"
+#include "chase_decoder.hpp"
+#include "hamming_encoder.hpp"
+#include "noise_generator.hpp"
+#include "soft_metric.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum Stage { kEncode, kModulate, kChannel, kLlr, kCombine, kDecode, kStages };
+
+constexpr std::array<const char*, kStages> kStageNames = {
+    "encode", "modulate", "channel", "llr", "combine", "decode"};
+
+struct StageTimes {
+  std::array<int64_t, kStages> ns{};
+
+  StageTimes& operator+=(const StageTimes& other) {
+    for (int s = 0; s < kStages; s++) {
+      ns[s] += other.ns[s];
+    }
+    return *this;
+  }
+};
+
+// Добавляет время жизни объекта к счётчику стадии: два чтения часов на
+// стадию кадра, без блокировок (у каждого потока свои StageTimes).
+class ScopedStage {
+ public:
+  ScopedStage(StageTimes& times, Stage stage)
+      : slot_(times.ns[stage]), start_(Clock::now()) {}
+  ~ScopedStage() {
+    slot_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 Clock::now() - start_)
+                 .count();
+  }
+
+  ScopedStage(const ScopedStage&) = delete;
+  ScopedStage& operator=(const ScopedStage&) = delete;
+
+ private:
+  int64_t& slot_;
+  Clock::time_point start_;
+};
+
+struct LinkConfig {
+  int r = 6;
+  int d = 4;
+  harq::ProbeAlgorithm algorithm = harq::ProbeAlgorithm::Second;
+  double snr_db = 2.0;
+  int rounds = 4;
+  int frames = 20000;
+  int threads = static_cast<int>(std::thread::hardware_concurrency());
+  uint32_t seed = 1;
+};
+
+struct LinkResult {
+  int64_t frames = 0;
+  int64_t delivered_bits = 0;
+  int64_t rounds = 0;
+  StageTimes times;
+};
+
+// Рабочее место одного потока: все буферы выделяются заранее.
+class Link {
+ public:
+  Link(const LinkConfig& config, const harq::AwgnChannel& channel,
+       uint64_t stream)
+      : config_(config), encoder_(config.r),
+        decoder_(config.r, config.d, config.algorithm),
+        channel_(channel.Fork(stream)), data_rng_(config.seed, stream),
+        length_(encoder_.n() + 1) {
+    data_.assign(encoder_.data_words(), 0);
+    codeword_.assign(encoder_.codeword_words(), 0);
+    symbols_.assign(length_, 0.0);
+    received_.assign(length_, 0.0);
+    soft_.assign(length_, 0.0);
+    decoded_.assign(encoder_.k(), 0);
+    // Данные — поток stream после прыжка на 2^128, как в Simulator: он не
+    // пересекается с шумом канала.
+    data_rng_.Jump();
+  }
+
+  void Run(LinkResult& result) {
+    const int k = encoder_.k();
+    for (int frame = 0; frame < config_.frames; frame++) {
+      {
+        ScopedStage stage(result.times, kEncode);
+        for (uint64_t& word : data_) {
+          word = data_rng_.Next();
+        }
+        data_.back() &=
+            harq::LowBitsMask(k - 64 * (encoder_.data_words() - 1));
+        encoder_.EncodeExtendedPacked(data_, codeword_);
+      }
+      {
+        ScopedStage stage(result.times, kModulate);
+        harq::BpskMapPacked(codeword_, symbols_);
+      }
+
+      std::fill(soft_.begin(), soft_.end(), 0.0);
+      bool delivered = false;
+      int round = 0;
+      while (!delivered && round < config_.rounds) {
+        round++;
+        {
+          ScopedStage stage(result.times, kChannel);
+          std::copy(symbols_.begin(), symbols_.end(), received_.begin());
+          channel_.AddNoiseInPlace(received_);
+        }
+        {
+          ScopedStage stage(result.times, kLlr);
+          harq::BpskDemapSoft(received_, channel_.noise_variance());
+        }
+        {
+          ScopedStage stage(result.times, kCombine);
+          harq::AccumulateLlr(soft_, received_);
+        }
+        {
+          ScopedStage stage(result.times, kDecode);
+          decoder_.Decode(std::span<const double>(soft_), decoded_);
+          delivered = true;
+          for (int i = 0; i < k; i++) {
+            delivered = delivered && decoded_[i] == harq::GetBit(data_, i);
+          }
+        }
+      }
+
+      result.frames++;
+      result.rounds += round;
+      result.delivered_bits += delivered ? k : 0;
+    }
+  }
+
+ private:
+  const LinkConfig& config_;
+  harq::HammingEncoder encoder_;
+  harq::ChaseDecoder decoder_;
+  harq::AwgnChannel channel_;
+  harq::Xoshiro256 data_rng_;
+  int length_;
+
+  std::vector<uint64_t> data_;
+  std::vector<uint64_t> codeword_;
+  std::vector<double> symbols_;
+  std::vector<double> received_;
+  std::vector<double> soft_;
+  std::vector<uint8_t> decoded_;
+};
+
+// Прогон на threads потоках; возвращает сумму по потокам и время стены.
+LinkResult RunThreads(const LinkConfig& config, int threads,
+                      double& wall_seconds) {
+  const harq::AwgnChannel channel(config.snr_db, config.seed);
+  std::vector<Link> links;
+  links.reserve(threads);
+  for (int t = 0; t < threads; t++) {
+    links.emplace_back(config, channel, static_cast<uint64_t>(t));
+  }
+  std::vector<LinkResult> results(threads);
+
+  const Clock::time_point start = Clock::now();
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&links, &results, t] { links[t].Run(results[t]); });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  wall_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  LinkResult total;
+  for (const LinkResult& result : results) {
+    total.frames += result.frames;
+    total.delivered_bits += result.delivered_bits;
+    total.rounds += result.rounds;
+    total.times += result.times;
+  }
+  return total;
+}
+
+// Наибольшее r бенчмарка: кадр из 2^16 битов уже далеко за пределами кэша.
+constexpr int kMaxBenchR = 16;
+constexpr int kAlgorithms = static_cast<int>(harq::ProbeAlgorithm::ThirdNested) + 1;
+
+// Значение флага --name=value или nullptr.
+const char* FlagValue(const char* arg, const char* name) {
+  const std::size_t length = std::strlen(name);
+  if (std::strncmp(arg, name, length) == 0 && arg[length] == '=') {
+    return arg + length + 1;
+  }
+  return nullptr;
+}
+
+LinkConfig ParseArgs(int argc, char** argv) {
+  LinkConfig config;
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    if (const char* value = FlagValue(arg, "--r")) {
+      config.r = std::atoi(value);
+    } else if (const char* value = FlagValue(arg, "--d")) {
+      config.d = std::atoi(value);
+    } else if (const char* value = FlagValue(arg, "--algorithm")) {
+      const int algorithm = std::atoi(value);
+      if (algorithm < 1 || algorithm > kAlgorithms) {
+        throw std::invalid_argument("Algorithm must be in 1.." +
+                                    std::to_string(kAlgorithms) + ".");
+      }
+      config.algorithm = static_cast<harq::ProbeAlgorithm>(algorithm - 1);
+    } else if (const char* value = FlagValue(arg, "--snr")) {
+      config.snr_db = std::atof(value);
+    } else if (const char* value = FlagValue(arg, "--rounds")) {
+      config.rounds = std::atoi(value);
+    } else if (const char* value = FlagValue(arg, "--frames")) {
+      config.frames = std::atoi(value);
+    } else if (const char* value = FlagValue(arg, "--threads")) {
+      config.threads = std::atoi(value);
+    } else if (const char* value = FlagValue(arg, "--seed")) {
+      config.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+    } else {
+      throw std::invalid_argument(std::string("Unknown flag: ") + arg);
+    }
+  }
+  if (config.threads <= 0) {
+    config.threads = 1;
+  }
+  if (config.frames <= 0 || config.rounds <= 0) {
+    throw std::invalid_argument("Frames and rounds must be positive.");
+  }
+  if (config.r < 2 || config.r > kMaxBenchR) {
+    throw std::invalid_argument("r must be in 2.." +
+                                std::to_string(kMaxBenchR) + ".");
+  }
+  // Расширенное слово — n+1 = 2^r позиций.
+  if (config.d < 1 || config.d > (1 << config.r)) {
+    throw std::invalid_argument("d must be in 1..2^r.");
+  }
+  return config;
+}
+
+// 1, 2, 4, ... и сам threads.
+std::vector<int> ThreadCounts(int threads) {
+  std::vector<int> counts;
+  for (int count = 1; count < threads; count *= 2) {
+    counts.push_back(count);
+  }
+  counts.push_back(threads);
+  return counts;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  LinkConfig config;
+  try {
+    config = ParseArgs(argc, argv);
+    // Остальные ограничения (например, число тестовых позиций) проверяют
+    // конструкторы декодера и канала; ошибка выводится до таблицы.
+    harq::ChaseDecoder(config.r, config.d, config.algorithm);
+    harq::AwgnChannel(config.snr_db, config.seed);
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+
+  std::printf("r=%d d=%d algorithm=%d snr=%.2f dB rounds=%d frames/thread=%d\n",
+              config.r, config.d, static_cast<int>(config.algorithm) + 1,
+              config.snr_db, config.rounds, config.frames);
+  std::printf("%8s %10s %12s %14s %9s %11s", "threads", "wall_s",
+              "Mbit/s", "Mbit/s/core", "speedup", "rounds/fr");
+  for (const char* name : kStageNames) {
+    std::printf(" %9s", name);
+  }
+  std::printf("\n");
+
+  try {
+    double single_rate = 0.0;
+    for (int threads : ThreadCounts(config.threads)) {
+      double wall = 0.0;
+      const LinkResult result = RunThreads(config, threads, wall);
+      const double rate = result.delivered_bits / wall / 1e6;
+      if (threads == 1) {
+        single_rate = rate;
+      }
+
+      int64_t staged = 0;
+      for (int64_t ns : result.times.ns) {
+        staged += ns;
+      }
+      std::printf("%8d %10.3f %12.3f %14.3f %9.2f %11.3f", threads, wall, rate,
+                  rate / threads, single_rate > 0.0 ? rate / single_rate : 0.0,
+                  static_cast<double>(result.rounds) / result.frames);
+      // Доля стадии в суммарном времени всех потоков, %.
+      for (int64_t ns : result.times.ns) {
+        std::printf(" %8.1f%%", staged > 0 ? 100.0 * ns / staged : 0.0);
+      }
+      std::printf("\n");
+    }
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,39 @@
+option(HARQ_BUILD_BENCHMARKS "Build the harq_bench and link_bench benchmarks" ON)
+if(HARQ_BUILD_BENCHMARKS)
+    find_package(benchmark QUIET)
+    if(NOT benchmark_FOUND)
+        include(FetchContent)
+
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+        FetchContent_Declare(
+            benchmark
+            GIT_REPOSITORY https://github.com/google/benchmark.git
+            GIT_TAG v1.8.3
+        )
+        FetchContent_MakeAvailable(benchmark)
+    endif()
+
+    add_executable(harq_bench ${CMAKE_CURRENT_LIST_DIR}/../bench/harq_bench.cpp)
+
+    target_link_libraries(harq_bench
+        PRIVATE
+            harq
+            benchmark::benchmark_main
+    )
+
+    # cmake --build build --target bench: прогон с отчётом JSON для
+    # сравнения версий.
+    add_custom_target(bench
+        COMMAND harq_bench
+            --benchmark_out=${CMAKE_BINARY_DIR}/harq_bench.json
+            --benchmark_out_format=json
+        DEPENDS harq_bench
+        USES_TERMINAL
+    )
+
+    # Сквозной бенчмарк линии с разбивкой по стадиям; свой main, без
+    # Google Benchmark.
+    add_executable(link_bench ${CMAKE_CURRENT_LIST_DIR}/../bench/link_bench.cpp)
+    target_link_libraries(link_bench PRIVATE harq)
+endif()
@@ -1,4 +1,4 @@
-set(CMAKE_CXX_STANDARD 17)
+set(CMAKE_CXX_STANDARD 20)
 set(CMAKE_CXX_STANDARD_REQUIRED ON)
 set(CMAKE_CXX_EXTENSIONS OFF)
 
@@ -11,3 +11,17 @@ add_library(harq STATIC ${HARQ_SOURCES})
 target_include_directories(harq PUBLIC
     ${CMAKE_CURRENT_LIST_DIR}/../include
 )
+
+option(HARQ_NATIVE_ARCH "Build for the host CPU (AVX2/BMI2 code paths)" OFF)
+if(HARQ_NATIVE_ARCH AND NOT MSVC)
+    target_compile_options(harq PUBLIC -march=native)
+endif()
+
+option(HARQ_ENABLE_INSTRUMENTATION
+    "Compile hot-path counters and per-stage cycle timers" OFF)
+if(HARQ_ENABLE_INSTRUMENTATION)
+    target_compile_definitions(harq PUBLIC HARQ_ENABLE_INSTRUMENTATION=1)
+endif()
+
+find_package(Threads REQUIRED)
+target_link_libraries(harq PUBLIC Threads::Threads)
@@ -1,12 +1,18 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <utility>
 #include <vector>
 
+#include "bpsk_passband.hpp"
+#include "noise_generator.hpp"
+
 namespace harq {
 
 // Канал АБГШ (AWGN) для BPSK при единичной мощности символов.
+// Состояние генератора шума сохраняется между вызовами: каждый кадр
+// получает новую реализацию шума.
 class AwgnChannel {
  public:
   explicit AwgnChannel(double snr_db, uint32_t seed = 5489u);
@@ -17,6 +23,9 @@ class AwgnChannel {
   // Возвращает символы с добавленным гауссовским шумом.
   std::vector<double> AddNoise(const std::vector<double>& symbols);
 
+  // Добавляет шум на месте, без копирования буфера.
+  void AddNoiseInPlace(std::span<double> symbols);
+
   // Вычисляет LLR для принятых символов при текущем SNR.
   std::vector<double> ComputeLlr(const std::vector<double>& received) const;
 
@@ -24,13 +33,61 @@ class AwgnChannel {
   std::pair<std::vector<double>, std::vector<double>> Transmit(
       const std::vector<double>& symbols);
 
+  // Канал с тем же SNR и seed, но независимым потоком шума stream_id —
+  // по одному на рабочий поток (см. NoiseStream::Fork).
+  AwgnChannel Fork(uint64_t stream_id) const;
+
+  // Сдвигает генератор на 2^128 отсчётов; копии канала, сдвинутые разное
+  // число раз, гарантированно не перекрываются.
+  void Jump();
+
+  double snr_db() const;
+  double noise_variance() const;
+
  private:
   void UpdateSigma();
 
   double snr_db_;
   double sigma2_;
   double sigma_;
-  uint32_t seed_;
+  NoiseStream noise_;
+};
+
+// Канал АБГШ для отсчётов BpskPassbandModulate. Задаётся Eb/N0: энергия
+// бита Eb = A^2 * samples_per_symbol * <c^2> (средняя мощность несущей по
+// её периоду), дисперсия шума на отсчёт sigma^2 = N0 / 2 = Eb / (2 Eb/N0).
+// На выходе согласованного фильтра SNR = 2 Eb/N0, то есть Eb/N0 = x дБ
+// соответствует AwgnChannel с SNR x + 3 дБ.
+class PassbandAwgnChannel {
+ public:
+  PassbandAwgnChannel(double ebn0_db, const BpskCarrierConfig& config,
+                      uint32_t seed = 5489u);
+
+  void SetEbN0Db(double ebn0_db);
+
+  // Добавляет шум на месте к блоку отсчётов любой длины; поток шума
+  // непрерывен между вызовами.
+  void AddNoiseInPlace(std::span<double> samples);
+
+  // Независимый поток шума stream_id (см. NoiseStream::Fork).
+  PassbandAwgnChannel Fork(uint64_t stream_id) const;
+  void Jump();
+
+  double ebn0_db() const;
+  double bit_energy() const;
+  // Дисперсия шума на отсчёт; её можно передать
+  // BpskPassbandSoftDemodulator.
+  double noise_variance() const;
+
+ private:
+  void UpdateSigma();
+
+  BpskCarrierConfig config_;
+  double ebn0_db_;
+  double bit_energy_;
+  double sigma2_;
+  double sigma_;
+  NoiseStream noise_;
 };
 
 }  // namespace harq
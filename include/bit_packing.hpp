@@ -0,0 +1,76 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace harq {
+
+// Упакованное представление битов: бит i вектора хранится в бите (i % 64)
+// слова i / 64, младшие биты идут первыми.
+
+inline constexpr std::size_t PackedWordCount(std::size_t bits) {
+  return (bits + 63) / 64;
+}
+
+inline constexpr uint64_t LowBitsMask(int len) {
+  return len >= 64 ? ~uint64_t{0} : ((uint64_t{1} << len) - 1);
+}
+
+inline int Parity64(uint64_t value) { return std::popcount(value) & 1; }
+
+inline int GetBit(std::span<const uint64_t> words, std::size_t index) {
+  return static_cast<int>((words[index / 64] >> (index % 64)) & 1);
+}
+
+inline void FlipBit(std::span<uint64_t> words, std::size_t index) {
+  words[index / 64] ^= uint64_t{1} << (index % 64);
+}
+
+// Читает len (<= 64) битов, начиная с позиции offset.
+inline uint64_t ReadBits(std::span<const uint64_t> words, std::size_t offset,
+                         int len) {
+  const std::size_t word = offset / 64;
+  const int shift = static_cast<int>(offset % 64);
+  uint64_t value = words[word] >> shift;
+  if (shift != 0 && shift + len > 64) {
+    value |= words[word + 1] << (64 - shift);
+  }
+  return value & LowBitsMask(len);
+}
+
+// Записывает len (<= 64) младших битов value, начиная с позиции offset.
+inline void WriteBits(std::span<uint64_t> words, std::size_t offset, int len,
+                      uint64_t value) {
+  const std::size_t word = offset / 64;
+  const int shift = static_cast<int>(offset % 64);
+  const uint64_t mask = LowBitsMask(len);
+  value &= mask;
+  words[word] = (words[word] & ~(mask << shift)) | (value << shift);
+  if (shift != 0 && shift + len > 64) {
+    const int spill = 64 - shift;
+    words[word + 1] =
+        (words[word + 1] & ~(mask >> spill)) | (value >> spill);
+  }
+}
+
+// Копирует len битов из src (с позиции src_offset) в dst (с dst_offset).
+void CopyBits(std::span<const uint64_t> src, std::size_t src_offset,
+              std::span<uint64_t> dst, std::size_t dst_offset,
+              std::size_t len);
+
+// Транспонирует блок 64x64 на месте: бит w слова p становится битом p
+// слова w. Переводит 64 упакованных слова в битовые срезы и обратно.
+void Transpose64(std::span<uint64_t, 64> block);
+
+// Упаковывает биты 0/1; бросает std::invalid_argument при других значениях.
+void PackBits(std::span<const uint8_t> bits, std::span<uint64_t> words);
+std::vector<uint64_t> PackBits(const std::vector<uint8_t>& bits);
+
+void UnpackBits(std::span<const uint64_t> words, std::span<uint8_t> bits);
+std::vector<uint8_t> UnpackBits(const std::vector<uint64_t>& words,
+                                std::size_t bits);
+
+}  // namespace harq
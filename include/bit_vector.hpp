@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace harq {
+
+// Упакованный битовый вектор: бит i хранится в бите i % 64 слова i / 64
+// (как в bit_packing.hpp). До kInlineBits битов слова лежат внутри объекта,
+// поэтому кодовые слова до r = 7 не обращаются к куче. Биты за size() в
+// последнем слове всегда нулевые.
+class BitVector {
+ public:
+  static constexpr std::size_t kInlineWords = 2;
+  static constexpr std::size_t kInlineBits = 64 * kInlineWords;
+
+  BitVector();
+  // size нулевых битов.
+  explicit BitVector(std::size_t size);
+  // Из битов 0/1; бросает std::invalid_argument при других значениях.
+  explicit BitVector(std::span<const uint8_t> bits);
+  explicit BitVector(const std::vector<uint8_t>& bits);
+
+  BitVector(const BitVector& other);
+  BitVector& operator=(const BitVector& other);
+  // Перемещённый вектор становится пустым.
+  BitVector(BitVector&& other) noexcept;
+  BitVector& operator=(BitVector&& other) noexcept;
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::size_t word_count() const { return (size_ + 63) / 64; }
+
+  // Слова представления; запись за size() нарушает инвариант.
+  std::span<uint64_t> words() { return {data(), word_count()}; }
+  std::span<const uint64_t> words() const { return {data(), word_count()}; }
+
+  int Get(std::size_t index) const {
+    return static_cast<int>((data()[index / 64] >> (index % 64)) & 1);
+  }
+  int operator[](std::size_t index) const { return Get(index); }
+  void Set(std::size_t index, int bit);
+  void Flip(std::size_t index) {
+    data()[index / 64] ^= uint64_t{1} << (index % 64);
+  }
+
+  // Изменяет длину; новые биты нулевые.
+  void Resize(std::size_t size);
+  void PushBack(int bit);
+
+  // Число единиц.
+  std::size_t Popcount() const;
+
+  // Пословный XOR векторов одинаковой длины.
+  BitVector& operator^=(const BitVector& other);
+  friend BitVector operator^(BitVector lhs, const BitVector& rhs) {
+    lhs ^= rhs;
+    return lhs;
+  }
+  bool operator==(const BitVector& other) const;
+
+  // Собирает биты позиций positions в новый вектор (бит i — позиция
+  // positions[i]); Scatter записывает биты values обратно по позициям.
+  BitVector Gather(std::span<const int> positions) const;
+  void Scatter(std::span<const int> positions, const BitVector& values);
+
+  // Совместимость с API на std::vector<uint8_t>.
+  std::vector<uint8_t> ToBytes() const;
+
+ private:
+  uint64_t* data() { return heap_ ? heap_.get() : inline_; }
+  const uint64_t* data() const { return heap_ ? heap_.get() : inline_; }
+  std::size_t capacity_words() const;
+  void ClearTail();
+
+  std::size_t size_;
+  std::size_t heap_words_;
+  std::unique_ptr<uint64_t[]> heap_;
+  uint64_t inline_[kInlineWords];
+};
+
+}  // namespace harq
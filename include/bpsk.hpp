@@ -1,16 +1,22 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
+#include "bit_vector.hpp"
+#include "soft_metric.hpp"
+
 namespace harq {
 
 class BpskModulator {
  public:
   std::vector<double> Modulate(const std::vector<uint8_t>& bits) const;
+  std::vector<double> Modulate(const BitVector& bits) const;
 };
 
 std::vector<double> BpskModulate(const std::vector<uint8_t>& bits);
+std::vector<double> BpskModulate(const BitVector& bits);
 
 class BpskDemodulator {
  public:
@@ -20,4 +26,44 @@ class BpskDemodulator {
 
 std::vector<uint8_t> BpskDemodulate(const std::vector<double>& symbols);
 
+// Ядра горячего пути без выделения памяти. Бит отображается в 2b - 1
+// арифметически, без ветвлений; байты bits не проверяются — для этого
+// есть отдельный проход ValidateBits.
+void ValidateBits(std::span<const uint8_t> bits);
+
+void BpskMap(std::span<const uint8_t> bits, std::span<double> symbols,
+             SimdLevel level = DetectSimdLevel());
+
+void BpskMap(std::span<const uint8_t> bits, std::span<float> symbols,
+             SimdLevel level = DetectSimdLevel());
+
+// symbols.size() битов из упакованных слов (раскладка bit_packing.hpp);
+// слов нужно не меньше PackedWordCount(symbols.size()).
+void BpskMapPacked(std::span<const uint64_t> words, std::span<double> symbols,
+                   SimdLevel level = DetectSimdLevel());
+
+void BpskMapPacked(std::span<const uint64_t> words, std::span<float> symbols,
+                   SimdLevel level = DetectSimdLevel());
+
+// Жёсткое решение (symbol >= 0 — бит 1).
+void BpskDemap(std::span<const double> symbols, std::span<uint8_t> bits,
+               SimdLevel level = DetectSimdLevel());
+
+void BpskDemap(std::span<const float> symbols, std::span<uint8_t> bits,
+               SimdLevel level = DetectSimdLevel());
+
+// Жёсткое решение сразу в упакованные слова по маске знаков; разряды
+// последнего слова за symbols.size() обнуляются.
+void BpskDemapPacked(std::span<const double> symbols,
+                     std::span<uint64_t> words,
+                     SimdLevel level = DetectSimdLevel());
+
+void BpskDemapPacked(std::span<const float> symbols, std::span<uint64_t> words,
+                     SimdLevel level = DetectSimdLevel());
+
+// Мягкое решение на месте: принятые отсчёты заменяются LLR
+// 2 y / noise_variance.
+void BpskDemapSoft(std::span<double> symbols, double noise_variance);
+void BpskDemapSoft(std::span<float> symbols, float noise_variance);
+
 }  // namespace harq
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
+#include "carrier_oscillator.hpp"
+#include "soft_metric.hpp"
+
 namespace harq {
 
 struct BpskCarrierConfig {
@@ -13,6 +18,11 @@ struct BpskCarrierConfig {
   double phase = 0.0;
 };
 
+// Бросает std::invalid_argument, если параметры несущей не конечны,
+// частота дискретизации или samples_per_symbol не положительны либо
+// частота несущей отрицательна.
+void ValidateCarrierConfig(const BpskCarrierConfig& config);
+
 class BpskPassbandModulator {
  public:
   explicit BpskPassbandModulator(BpskCarrierConfig config);
@@ -34,6 +44,102 @@ class BpskPassbandDemodulator {
   BpskCarrierConfig config_;
 };
 
+// Потоковый модулятор: фаза несущей продолжается между вызовами Process,
+// поэтому длинную последовательность битов можно подавать блоками.
+class BpskPassbandStreamModulator {
+ public:
+  explicit BpskPassbandStreamModulator(BpskCarrierConfig config);
+
+  // Пишет в samples ровно bits.size() * samples_per_symbol отсчётов.
+  void Process(std::span<const uint8_t> bits, std::span<double> samples);
+
+  // Возвращает несущую к отсчёту 0.
+  void Reset();
+  // Число выданных отсчётов.
+  uint64_t position() const;
+
+ private:
+  BpskCarrierConfig config_;
+  CarrierOscillator carrier_;
+};
+
+// Потоковый демодулятор: принимает блоки отсчётов любой длины (например,
+// из кольцевого буфера), незавершённый символ копится до следующего
+// вызова. Память ограничена буфером несущей на kCarrierBlock отсчётов.
+class BpskPassbandStreamDemodulator {
+ public:
+  static constexpr std::size_t kCarrierBlock = 1024;
+
+  explicit BpskPassbandStreamDemodulator(BpskCarrierConfig config);
+
+  // Число символов, которое завершит блок из samples отсчётов.
+  std::size_t SymbolsFor(std::size_t samples) const;
+
+  // Демодулирует samples; решения по завершённым символам пишутся в начало
+  // bits (нужно не меньше SymbolsFor(samples.size())), возвращается их
+  // число.
+  std::size_t Process(std::span<const double> samples,
+                      std::span<uint8_t> bits);
+
+  // Сбрасывает фазу несущей и накопленную часть символа.
+  void Reset();
+  // Отсчётов, накопленных в текущем незавершённом символе.
+  int pending_samples() const;
+
+ private:
+  BpskCarrierConfig config_;
+  CarrierOscillator oscillator_;
+  std::vector<double> carrier_;
+  double accum_;
+  int filled_;
+};
+
+// Потоковый демодулятор с мягким выходом: выход согласованного фильтра
+// (корреляция с несущей по символу, y = Σ r_k c_k) переводится в LLR
+// 2 A y / σ², где σ² — дисперсия шума на отсчёт, A — amplitude. Для
+// r_k = A s c_k + n_k это точный LLR при любой энергии несущей в символе.
+// LLR >= 0 соответствует биту 1, выход можно подавать в ChaseDecoder и
+// HARQ. Интегрирование со сбросом по samples_per_symbol отсчётам
+// выполняется векторно (AVX2).
+class BpskPassbandSoftDemodulator {
+ public:
+  // noise_variance — известная дисперсия шума на отсчёт; 0 — оценивать по
+  // принятому сигналу: остаток r_k - A ŝ c_k после жёсткого решения ŝ
+  // накапливается по всем завершённым символам с последнего Reset().
+  explicit BpskPassbandSoftDemodulator(BpskCarrierConfig config,
+                                       double noise_variance = 0.0);
+
+  std::size_t SymbolsFor(std::size_t samples) const;
+
+  // LLR завершённых символов пишутся в начало llr (нужно не меньше
+  // SymbolsFor(samples.size())), возвращается их число. При оценке шума
+  // LLR символа масштабируется оценкой с учётом этого символа.
+  std::size_t Process(std::span<const double> samples, std::span<double> llr);
+
+  // Заданная или текущая оценённая дисперсия шума на отсчёт.
+  double noise_variance() const;
+  bool estimates_noise() const;
+
+  void Reset();
+  int pending_samples() const;
+
+ private:
+  BpskCarrierConfig config_;
+  CarrierOscillator oscillator_;
+  std::vector<double> carrier_;
+  double fixed_variance_;
+  SimdLevel level_;
+
+  // Суммы незавершённого символа: Σ r c, Σ c², Σ r².
+  double correlation_;
+  double carrier_energy_;
+  double sample_energy_;
+  int filled_;
+
+  double residual_energy_;
+  uint64_t residual_samples_;
+};
+
 std::vector<double> BpskPassbandModulate(
     const std::vector<uint8_t>& bits,
     BpskCarrierConfig config);
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace harq {
+
+// Генератор несущей cos(2π f n / fs + phase) для n = 0, 1, 2, ... без
+// вызова cos на каждый отсчёт. Если f / fs = m / P с периодом P не больше
+// kMaxTablePeriod, отсчёты берутся из таблицы одного периода (фаза каждого
+// элемента вычислена точно). Иначе работает комплексный ротатор
+// z <- z * e^{jω}, модуль которого восстанавливается каждые
+// kRenormInterval шагов. Фаза непрерывна между вызовами Generate, поэтому
+// длинный сигнал можно обрабатывать кусками любой длины.
+class CarrierOscillator {
+ public:
+  static constexpr std::size_t kMaxTablePeriod = 4096;
+  static constexpr int kRenormInterval = 256;
+
+  CarrierOscillator(double carrier_hz, double sample_rate_hz,
+                    double phase = 0.0);
+
+  // Записывает следующие out.size() отсчётов несущей.
+  void Generate(std::span<double> out);
+
+  // Возвращает генератор к отсчёту 0.
+  void Reset();
+
+  // Номер следующего отсчёта.
+  uint64_t position() const;
+  // Длина таблицы периода или 0 для ротатора.
+  std::size_t period() const;
+  bool tabulated() const;
+
+ private:
+  void Renormalize();
+
+  double carrier_hz_;
+  double sample_rate_hz_;
+  double phase_;
+  uint64_t position_;
+
+  std::vector<double> table_;
+  std::size_t table_index_;
+
+  // Ротатор: текущее значение z и шаг e^{jω}.
+  double re_;
+  double im_;
+  double step_re_;
+  double step_im_;
+  int since_renorm_;
+};
+
+}  // namespace harq
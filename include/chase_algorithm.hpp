@@ -1,13 +1,23 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "bit_vector.hpp"
+
 namespace harq {
 
 const int HAMMING_CODE_DISTANCE = 3;
 
-enum class ProbeAlgorithm { First, Second, Third };
+// Third — одна тестовая последовательность по рангам 0, 2, 4, ... (или
+// 0, 1, 3, 5, ...) наименее надёжных позиций, как в
+// generate_probe_sequences_3. ThirdNested — полный набор алгоритма 3
+// Чейза: единицы в m наименее надёжных позициях для m = 0, 2, 4, ..., d-1
+// (нечётное d) или m = 0, 1, 3, ..., d-1; первый кандидат — само жёсткое
+// решение.
+enum class ProbeAlgorithm { First, Second, Third, ThirdNested };
 
 std::vector<std::vector<uint8_t>> generate_probe_sequences_1(int n, int d);
 
@@ -22,8 +32,36 @@ generate_probe_sequences_3(int n, int d,
 std::vector<uint8_t> AddErrorVector(const std::vector<uint8_t> &DataVector,
                                     const std::vector<uint8_t> &ErrorVector);
 
+BitVector AddErrorVector(const BitVector &DataVector,
+                         const BitVector &ErrorVector);
+
 std::vector<std::vector<uint8_t>>
 CalculateCandidates(const std::vector<uint8_t> &message, int r, int d,
                     const std::vector<double> &reliability,
                     ProbeAlgorithm algorithm);
+
+// Упакованный вариант: пробные последовательности накладываются XOR по
+// словам, кандидаты исправляются без распаковки.
+std::vector<BitVector>
+CalculateCandidates(const BitVector &message, int r, int d,
+                    const std::vector<double> &reliability,
+                    ProbeAlgorithm algorithm);
+
+std::pair<double, std::vector<uint8_t>>
+CalculateDistance(const std::vector<uint8_t> &candidate,
+                  const std::vector<double> &SoftDecisions);
+
+std::vector<uint8_t>
+MakeDecision(const std::vector<std::vector<uint8_t>> &candidates,
+             const std::vector<double> &SoftDecisions);
+
+// Выбор по квантованным LLR (LlrQuantizer, q >= 0 — бит 1): кандидаты
+// оцениваются целочисленным ядром ScoreCandidates с метрикой в int32_t.
+std::vector<uint8_t>
+MakeDecision(const std::vector<std::vector<uint8_t>> &candidates,
+             std::span<const int8_t> llr);
+
+std::vector<uint8_t>
+MakeDecision(const std::vector<std::vector<uint8_t>> &candidates,
+             std::span<const int16_t> llr);
 } // namespace harq
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "chase_algorithm.hpp"
+#include "hamming_decoder.hpp"
+#include "probe_patterns.hpp"
+
+namespace harq {
+
+// Декодер Чейза с переиспользуемым рабочим пространством: таблица тестовых
+// последовательностей и буферы выделяются в конструкторе, поэтому Decode
+// не обращается к куче. Кандидаты оцениваются потоково за один проход.
+class ChaseDecoder {
+ public:
+  ChaseDecoder(int r, int d, ProbeAlgorithm algorithm);
+
+  int n() const;
+  int k() const;
+
+  // Число тестовых последовательностей (кандидатов) на одно слово.
+  int patterns() const;
+
+  // llr — n или n+1 (расширенный код) значений, LLR >= 0 соответствует
+  // биту 1. В out записываются k информационных битов лучшего кандидата.
+  void Decode(std::span<const double> llr, std::span<uint8_t> out);
+
+  // Квантованные LLR (см. LlrQuantizer): метрика накапливается в int32_t,
+  // результат совпадает с double-путём на тех же целых значениях.
+  void Decode(std::span<const int8_t> llr, std::span<uint8_t> out);
+  void Decode(std::span<const int16_t> llr, std::span<uint8_t> out);
+
+ private:
+  void BuildPatterns();
+  template <typename T>
+  void DecodeLlr(std::span<const T> llr, std::span<uint8_t> out);
+  // Записывает в probe позиции тестовой последовательности; возвращает их число.
+  int ProbePositions(int pattern, int* probe) const;
+
+  HammingDecoder decoder_;
+  int d_;
+  ProbeAlgorithm algorithm_;
+  int patterns_;
+  int flips_;
+  int selection_;
+  int words_;
+
+  // Для First и Third — общая таблица из кэша (позиции или ранги).
+  std::shared_ptr<const ProbePatternTable> table_;
+  // Для ThirdNested — число инвертируемых наименее надёжных позиций.
+  std::vector<int> probe_table_;
+  std::vector<std::size_t> least_reliable_;
+  // Флаги позиций, инвертированных текущей тестовой последовательностью.
+  std::vector<uint8_t> in_pattern_;
+  std::vector<uint64_t> hard_;
+  std::vector<uint64_t> candidate_;
+  std::vector<uint64_t> data_;
+};
+
+}  // namespace harq
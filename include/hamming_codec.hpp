@@ -0,0 +1,189 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "bit_packing.hpp"
+#include "hamming_decoder.hpp"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace harq {
+
+// Код Хэмминга (2^R - 1, 2^R - 1 - R) с r, известным при компиляции.
+// Раскладка та же, что у упакованного пути HammingEncoder/HammingDecoder:
+// бит i слова — позиция i+1, общий паритет — бит n. Все таблицы строятся
+// constexpr, циклы имеют постоянную длину R и разворачиваются компилятором.
+template <int R>
+class HammingCodec {
+  static_assert(R >= 2 && R <= HammingDecoder::kMaxSingleWordR,
+                "HammingCodec expects 2 <= R <= 6.");
+
+ public:
+  using DecodeStatus = HammingDecoder::DecodeStatus;
+
+  static constexpr int kR = R;
+  static constexpr int kN = (1 << R) - 1;
+  static constexpr int kK = kN - R;
+
+  // Строка j матрицы H: позиции, номер которых содержит разряд 2^j.
+  static constexpr std::array<uint64_t, R> kParityCheckMasks = [] {
+    std::array<uint64_t, R> masks{};
+    for (int j = 0; j < R; j++) {
+      for (int pos = 1; pos <= kN; pos++) {
+        if ((pos >> j) & 1) {
+          masks[j] |= uint64_t{1} << (pos - 1);
+        }
+      }
+    }
+    return masks;
+  }();
+
+  // kDataPositions[i] — индекс бита слова для i-го информационного бита.
+  static constexpr std::array<uint8_t, kK> kDataPositions = [] {
+    std::array<uint8_t, kK> positions{};
+    int i = 0;
+    for (int pos = 1; pos <= kN; pos++) {
+      if ((pos & (pos - 1)) != 0) {
+        positions[i++] = static_cast<uint8_t>(pos - 1);
+      }
+    }
+    return positions;
+  }();
+
+  static constexpr uint64_t kDataMask = [] {
+    uint64_t mask = 0;
+    for (uint8_t position : kDataPositions) {
+      mask |= uint64_t{1} << position;
+    }
+    return mask;
+  }();
+
+  // Строки G: кодовое слово для единичного i-го бита данных.
+  static constexpr std::array<uint64_t, kK> kGeneratorRows = [] {
+    std::array<uint64_t, kK> rows{};
+    for (int i = 0; i < kK; i++) {
+      uint64_t row = uint64_t{1} << kDataPositions[i];
+      for (int j = 0; j < R; j++) {
+        if (std::popcount(row & kParityCheckMasks[j]) & 1) {
+          row |= uint64_t{1} << ((1 << j) - 1);
+        }
+      }
+      rows[i] = row;
+    }
+    return rows;
+  }();
+
+  // Синдром -> маска бита, который нужно инвертировать (0 без ошибки).
+  static constexpr std::array<uint64_t, kN + 1> kErrorMasks = [] {
+    std::array<uint64_t, kN + 1> masks{};
+    for (int syndrome = 1; syndrome <= kN; syndrome++) {
+      masks[syndrome] = uint64_t{1} << (syndrome - 1);
+    }
+    return masks;
+  }();
+
+  // Данные раскладываются отрезками [2^j + 1, 2^(j+1) - 1] позиций, затем
+  // дописываются паритеты; биты data выше k игнорируются.
+  static constexpr uint64_t Encode(uint64_t data) {
+    uint64_t codeword = 0;
+    int offset = 0;
+    for (int j = 1; j < R; j++) {
+      const int run = (1 << j) - 1;
+      codeword |= ((data >> offset) & LowBitsMask(run)) << (1 << j);
+      offset += run;
+    }
+    for (int j = 0; j < R; j++) {
+      codeword |= static_cast<uint64_t>(
+                      std::popcount(codeword & kParityCheckMasks[j]) & 1)
+                  << ((1 << j) - 1);
+    }
+    return codeword;
+  }
+
+  static constexpr uint64_t EncodeExtended(uint64_t data) {
+    const uint64_t codeword = Encode(data);
+    return codeword | (static_cast<uint64_t>(std::popcount(codeword) & 1)
+                       << kN);
+  }
+
+  static constexpr int Syndrome(uint64_t codeword) {
+    int syndrome = 0;
+    for (int j = 0; j < R; j++) {
+      syndrome |= (std::popcount(codeword & kParityCheckMasks[j]) & 1) << j;
+    }
+    return syndrome;
+  }
+
+  // Исправляет слово на месте; правила те же, что у HammingDecoder.
+  static constexpr DecodeStatus Correct(uint64_t& codeword, bool extended) {
+    const int syndrome = Syndrome(codeword);
+    if (!extended) {
+      codeword ^= kErrorMasks[syndrome];
+      return syndrome != 0 ? DecodeStatus::kCorrected
+                           : DecodeStatus::kNoError;
+    }
+
+    const int parity = std::popcount(codeword & LowBitsMask(kN + 1)) & 1;
+    if (parity == 0) {
+      return syndrome != 0 ? DecodeStatus::kDetectedDouble
+                           : DecodeStatus::kNoError;
+    }
+    if (syndrome == 0) {
+      codeword ^= uint64_t{1} << kN;
+      return DecodeStatus::kParityCorrected;
+    }
+    codeword ^= kErrorMasks[syndrome];
+    return DecodeStatus::kCorrected;
+  }
+
+  static constexpr uint64_t ExtractData(uint64_t codeword) {
+#if defined(__BMI2__)
+    if (!std::is_constant_evaluated()) {
+      return _pext_u64(codeword, kDataMask);
+    }
+#endif
+    uint64_t data = 0;
+    int offset = 0;
+    for (int j = 1; j < R; j++) {
+      const int run = (1 << j) - 1;
+      data |= ((codeword >> (1 << j)) & LowBitsMask(run)) << offset;
+      offset += run;
+    }
+    return data;
+  }
+
+  static constexpr DecodeStatus Decode(uint64_t codeword, bool extended,
+                                       uint64_t& data) {
+    const DecodeStatus status = Correct(codeword, extended);
+    data = ExtractData(codeword);
+    return status;
+  }
+};
+
+// Вызывает f(HammingCodec<r>{}) для r из [2, kMaxSingleWordR]; так классы
+// с r времени выполнения переходят на специализированный код одним switch.
+template <typename F>
+constexpr decltype(auto) VisitHammingCodec(int r, F&& f) {
+  switch (r) {
+    case 2:
+      return f(HammingCodec<2>{});
+    case 3:
+      return f(HammingCodec<3>{});
+    case 4:
+      return f(HammingCodec<4>{});
+    case 5:
+      return f(HammingCodec<5>{});
+    case 6:
+      return f(HammingCodec<6>{});
+    default:
+      throw std::invalid_argument("HammingCodec expects 2 <= r <= 6.");
+  }
+}
+
+}  // namespace harq
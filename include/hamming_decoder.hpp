@@ -1,9 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <utility>
 #include <vector>
 
+#include "bit_vector.hpp"
+
 namespace harq {
 
 // Модуль декодера Хэмминга: исправляет одиночную ошибку по синдрому.
@@ -27,18 +30,86 @@ class HammingDecoder {
   // Исправляет кодовое слово и извлекает k информационных битов.
   std::vector<uint8_t> Decode(const std::vector<uint8_t>& codeword) const;
 
+  // То же для упакованного слова из n или n+1 битов.
+  BitVector Correct(const BitVector& codeword) const;
+  BitVector Decode(const BitVector& codeword) const;
+
   // Возвращает данные и статус декодирования (включая детекцию двойной ошибки).
   std::pair<std::vector<uint8_t>, DecodeStatus> DecodeWithStatus(
       const std::vector<uint8_t>& codeword) const;
 
+  // Наибольшее r, при котором расширенное кодовое слово помещается в uint64_t.
+  static constexpr int kMaxSingleWordR = 6;
+
+  // Число 64-битных слов упакованных данных и кодового слова (n+1 битов).
+  int data_words() const;
+  int codeword_words() const;
+
+  // Упакованный путь (r <= kMaxSingleWordR), бит i слова — позиция i+1.
+  // Бит j синдрома равен popcount(codeword & H_j) & 1. Выполняется
+  // специализацией HammingCodec<r> с таблицами времени компиляции.
+  int SyndromePacked(uint64_t codeword) const;
+
+  // Исправляет слово на месте одним XOR с однобитовой маской.
+  DecodeStatus CorrectPacked(uint64_t& codeword, bool extended) const;
+
+  // Собирает k информационных битов (PEXT по маске позиций данных).
+  uint64_t ExtractDataPacked(uint64_t codeword) const;
+
+  DecodeStatus DecodePacked(uint64_t codeword, bool extended,
+                            uint64_t& data) const;
+
+  // Многословный вариант для любого r: codeword содержит codeword_words()
+  // слов (n или n+1 значимых битов), data — data_words() слов. При
+  // r <= kMaxSingleWordR переходит на однословный путь.
+  int SyndromePacked(std::span<const uint64_t> codeword) const;
+  DecodeStatus DecodePacked(std::span<const uint64_t> codeword, bool extended,
+                            std::span<uint64_t> data) const;
+
+  // Пакетное декодирование в битово-срезанном виде (r <= kMaxBatchR).
+  // Срез p — это бит p всех кодовых слов блока: бит w слова среза
+  // относится к кодовому слову w. Синдромы всех слов считаются побитовыми
+  // операциями над срезами.
+  static constexpr int kBatchSize = 64;
+  static constexpr int kWideBatchSize = 256;
+  static constexpr int kMaxBatchR = 10;
+
+  // 64 слова: codeword_slices — n (или n+1 для extended) срезов по одному
+  // uint64_t, data_slices — k срезов, statuses — kBatchSize статусов.
+  void DecodeBatch(std::span<const uint64_t> codeword_slices, bool extended,
+                   std::span<uint64_t> data_slices,
+                   std::span<DecodeStatus> statuses) const;
+
+  // 256 слов: срез p занимает 4 подряд идущих uint64_t (слово 64*l + w —
+  // бит w элемента l), что соответствует одной дорожке AVX2.
+  void DecodeBatch256(std::span<const uint64_t> codeword_slices,
+                      bool extended, std::span<uint64_t> data_slices,
+                      std::span<DecodeStatus> statuses) const;
+
  private:
   static bool IsPowerOfTwo(int value);
-  int ComputeSyndrome(const std::vector<uint8_t>& codeword) const;
+  void ValidateCodeword(const std::vector<uint8_t>& codeword) const;
+  void ValidateCodeword(const BitVector& codeword) const;
+  void BuildPackedTables();
+  void CheckSingleWord() const;
+  template <int Lanes>
+  void DecodeSliced(std::span<const uint64_t> codeword_slices, bool extended,
+                    std::span<uint64_t> data_slices,
+                    std::span<DecodeStatus> statuses) const;
+  // Классифицирует синдром; в flip_position возвращает индекс бита для
+  // исправления (или -1).
+  DecodeStatus Classify(int syndrome, int overall_parity, bool extended,
+                        int& flip_position) const;
 
   int r_;
   int n_;
   int k_;
   std::vector<int> data_positions_;
+
+  int data_words_;
+  int codeword_words_;
+  // Проверочные строки H: h_rows_[j * codeword_words_ + w].
+  std::vector<uint64_t> h_rows_;
 };
 
 }  // namespace harq
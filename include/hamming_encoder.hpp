@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
+#include "bit_vector.hpp"
+
 namespace harq {
 
 // Модуль кодера Хэмминга: строит коды (2^r - 1, 2^r - 1 - r) и матрицу G.
@@ -22,10 +25,37 @@ class HammingEncoder {
   // Кодирует k битов данных в расширенное кодовое слово (n+1) с общим паритетом.
   std::vector<uint8_t> EncodeExtended(const std::vector<uint8_t>& data) const;
 
+  // То же для упакованных битов: без распаковки и без кучи до r = 7.
+  BitVector Encode(const BitVector& data) const;
+  BitVector EncodeExtended(const BitVector& data) const;
+
+  // Наибольшее r, при котором расширенное кодовое слово помещается в uint64_t.
+  static constexpr int kMaxSingleWordR = 6;
+
+  // Число 64-битных слов упакованных данных и кодового слова (n+1 битов).
+  int data_words() const;
+  int codeword_words() const;
+
+  // Упакованное кодирование (r <= kMaxSingleWordR): бит i данных — i-й
+  // информационный бит, бит i кодового слова — позиция i+1. Выполняется
+  // специализацией HammingCodec<r>; биты данных выше k игнорируются.
+  uint64_t EncodePacked(uint64_t data) const;
+  uint64_t EncodeExtendedPacked(uint64_t data) const;
+
+  // Многословный вариант для любого r: data содержит data_words() слов,
+  // codeword — codeword_words() слов. Паритеты считаются через popcount
+  // масок; при r <= kMaxSingleWordR работает однословный путь.
+  void EncodePacked(std::span<const uint64_t> data,
+                    std::span<uint64_t> codeword) const;
+  void EncodeExtendedPacked(std::span<const uint64_t> data,
+                            std::span<uint64_t> codeword) const;
+
  private:
   static bool IsPowerOfTwo(int value);
   std::vector<uint8_t> BuildCodewordFromData(
       const std::vector<uint8_t>& data) const;
+  void ValidateData(const std::vector<uint8_t>& data) const;
+  void BuildPackedTables();
 
   int r_;
   int n_;
@@ -33,6 +63,11 @@ class HammingEncoder {
   std::vector<int> parity_positions_;
   std::vector<int> data_positions_;
   std::vector<std::vector<uint8_t>> generator_;
+
+  int data_words_;
+  int codeword_words_;
+  // parity_masks_[j * codeword_words_ + w] — позиции, проверяемые паритетом 2^j.
+  std::vector<uint64_t> parity_masks_;
 };
 
 }  // namespace harq
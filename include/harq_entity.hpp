@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "chase_algorithm.hpp"
+#include "chase_decoder.hpp"
+
+namespace harq {
+
+// Набор процессов HARQ (объединение по Чейзу) с общим хранилищем. Мягкие
+// буферы всех процессов лежат в одной выровненной по 64 байтам области:
+// строка процесса id начинается с id * stride() и занимает целое число
+// кэш-линий. Состояние процессов хранится массивами по id, выделение и
+// освобождение — O(1) через стек свободных номеров.
+class HarqEntity {
+ public:
+  HarqEntity(int processes, int r, int d, ProbeAlgorithm algorithm,
+             int max_rounds, bool extended = false);
+
+  int capacity() const;
+  int active() const;
+  int n() const;
+  int k() const;
+  // Длина мягкого буфера процесса: n или n+1.
+  int length() const;
+  // Шаг между буферами соседних процессов (в double).
+  std::size_t stride() const;
+  int max_rounds() const;
+
+  // Возвращает номер свободного процесса с обнулёнными мягким буфером и
+  // решением или -1.
+  int Allocate();
+  void Release(int process);
+
+  // Складывает scale * llr (length() значений, например результат
+  // AwgnChannel::ComputeLlr) с буфером процесса и ставит его в очередь
+  // декодирования.
+  void Receive(int process, std::span<const double> llr, double scale = 1.0);
+
+  // Декодирует все процессы, получившие данные после прошлого слота;
+  // возвращает их число. Решения доступны через decoded().
+  int ProcessSlot();
+
+  int rounds(int process) const;
+  std::span<const double> soft_buffer(int process) const;
+  std::span<const uint8_t> decoded(int process) const;
+
+ private:
+  struct AlignedDelete {
+    void operator()(double* data) const;
+  };
+
+  void CheckActive(int process) const;
+
+  ChaseDecoder decoder_;
+  int capacity_;
+  int length_;
+  std::size_t stride_;
+  int max_rounds_;
+
+  std::unique_ptr<double[], AlignedDelete> soft_;
+  std::vector<uint8_t> decoded_;
+  std::vector<int> rounds_;
+  std::vector<uint8_t> active_;
+  // Позиция процесса в pending_ или -1.
+  std::vector<int> pending_index_;
+  std::vector<int> pending_;
+  std::vector<int> free_;
+};
+
+}  // namespace harq
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "awgn_channel.hpp"
+#include "chase_algorithm.hpp"
+#include "chase_decoder.hpp"
+#include "llr_quantizer.hpp"
+
+namespace harq {
+
+// Итог передачи пакета процессом HARQ.
+struct HarqResult {
+  bool success;
+  // Число использованных передач (1 — без повторов).
+  int rounds;
+  // Число переданных в канал символов за все раунды.
+  int symbols;
+};
+
+// Способ использования повторных передач.
+enum class HarqMode {
+  // Каждый раунд повторяет всё кодовое слово, LLR складываются.
+  kChaseCombining,
+  // Инкрементная избыточность по расширенному коду: первый раунд несёт
+  // данные и часть паритетов, следующий — остальные паритеты и общий
+  // паритет; дальше окно идёт по кольцевому буферу заново.
+  kIncrementalRedundancy
+};
+
+// Процесс HARQ: LLR каждой передачи накапливаются в мягком буфере по
+// позициям кодового слова (непереданные позиции остаются стёртыми, LLR 0),
+// после каждого раунда буфер декодируется алгоритмом Чейза. Буферы и
+// таблицы выкалывания строятся в конструкторе.
+class HarqProcess {
+ public:
+  // extended — передаётся расширенное слово (n+1) с общим паритетом;
+  // режим kIncrementalRedundancy требует extended.
+  HarqProcess(int r, int d, ProbeAlgorithm algorithm, int max_rounds,
+              bool extended = false,
+              HarqMode mode = HarqMode::kChaseCombining);
+
+  int n() const;
+  int k() const;
+  // Длина кодового слова в мягком буфере: n или n+1.
+  int length() const;
+  int max_rounds() const;
+  int round() const;
+  HarqMode mode() const;
+
+  // Позиции кодового слова, передаваемые в раунде round (с 0), в порядке
+  // передачи. Таблица предвычислена для всех max_rounds раундов.
+  std::span<const int> RoundPositions(int round) const;
+
+  // Переводит процесс на квантованные LLR (bits <= 8): каждая передача
+  // квантуется, буфер хранит int8_t и складывается с насыщением до
+  // max_level(), декодер работает в целых числах. Сбрасывает процесс.
+  void SetQuantizer(const LlrQuantizer& quantizer);
+  bool quantized() const;
+
+  // Начинает новый пакет: обнуляет буфер и счётчик раундов.
+  void Reset();
+
+  // Складывает LLR очередной передачи (RoundPositions(round()).size()
+  // значений, например AwgnChannel::Transmit(...).second) с буфером и
+  // декодирует его.
+  void Receive(std::span<const double> llr);
+
+  // Передаёт symbols (length() символов всего кодового слова) через
+  // channel до успеха или исчерпания max_rounds. Успех — совпадение
+  // декодированных битов с data (идеальный CRC). Шум добавляется в рабочий
+  // буфер, LLR сразу накапливаются в мягком.
+  HarqResult Transmit(std::span<const uint8_t> data,
+                      std::span<const double> symbols, AwgnChannel& channel);
+
+  // Накопленные LLR и решение последнего декодирования (k битов).
+  // В квантованном режиме буфер — quantized_buffer().
+  std::span<const double> soft_buffer() const;
+  std::span<const int8_t> quantized_buffer() const;
+  std::span<const uint8_t> decoded() const;
+
+ private:
+  void BuildPuncturing(int r);
+  // Добавляет scale * llr к позициям текущего раунда и декодирует буфер.
+  void CombineAndDecode(std::span<const double> llr, double scale);
+
+  ChaseDecoder decoder_;
+  int max_rounds_;
+  int length_;
+  HarqMode mode_;
+  int round_;
+
+  // Позиции раунда t — round_positions_[round_offsets_[t] ..
+  // round_offsets_[t + 1]).
+  std::vector<int> round_positions_;
+  std::vector<int> round_offsets_;
+
+  std::vector<double> soft_;
+  std::vector<double> received_;
+  std::vector<uint8_t> decoded_;
+
+  std::optional<LlrQuantizer> quantizer_;
+  std::vector<int8_t> soft_fixed_;
+  std::vector<int8_t> received_fixed_;
+};
+
+}  // namespace harq
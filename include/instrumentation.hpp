@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Счётчики горячего пути. Включаются опцией CMake
+// HARQ_ENABLE_INSTRUMENTATION; без неё макросы HARQ_COUNT* и HARQ_STAGE
+// раскрываются в пустые выражения и ничего не стоят. Collect() и Reset()
+// доступны всегда (без инструментирования возвращают нули).
+#if defined(HARQ_ENABLE_INSTRUMENTATION) && HARQ_ENABLE_INSTRUMENTATION
+#define HARQ_INSTRUMENTATION_ENABLED 1
+#else
+#define HARQ_INSTRUMENTATION_ENABLED 0
+#endif
+
+// rdtsc берётся из x86intrin.h только при включённом инструментировании
+// на x86 с GCC/Clang; иначе ReadCycles() считает по steady_clock.
+#if HARQ_INSTRUMENTATION_ENABLED && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HARQ_INSTRUMENTATION_RDTSC 1
+#include <x86intrin.h>
+#else
+#define HARQ_INSTRUMENTATION_RDTSC 0
+#include <chrono>
+#endif
+
+namespace harq::instrumentation {
+
+inline constexpr bool kEnabled = HARQ_INSTRUMENTATION_ENABLED != 0;
+
+enum class Counter {
+  // Тестовые последовательности, оценённые декодером Чейза.
+  kCandidates,
+  // Различные кодовые слова среди исправленных кандидатов.
+  kDistinctCandidates,
+  // Кандидаты с нулевым синдромом (уже кодовые слова).
+  kSyndromeZero,
+  kHarqSuccesses,
+  kHarqFailures,
+  kCount
+};
+
+// Стадии, для которых копятся такты (rdtsc) и число вызовов.
+enum class Stage { kChannel, kLlr, kCombine, kChaseDecode, kCount };
+
+inline constexpr int kCounterCount = static_cast<int>(Counter::kCount);
+inline constexpr int kStageCount = static_cast<int>(Stage::kCount);
+// По значениям HammingDecoder::DecodeStatus.
+inline constexpr int kStatusCount = 4;
+// Гистограмма раундов успешных передач HARQ: корзина t — успех за t+1
+// раундов, последняя собирает kRoundBins раундов и больше.
+inline constexpr int kRoundBins = 16;
+
+struct Snapshot {
+  std::array<uint64_t, kCounterCount> counters{};
+  std::array<uint64_t, kStatusCount> statuses{};
+  std::array<uint64_t, kRoundBins> success_rounds{};
+  std::array<uint64_t, kStageCount> stage_cycles{};
+  std::array<uint64_t, kStageCount> stage_calls{};
+
+  uint64_t counter(Counter counter) const {
+    return counters[static_cast<int>(counter)];
+  }
+  // Средние такты на вызов стадии (0 без вызовов).
+  double cycles_per_call(Stage stage) const;
+  // Среднее число раундов на успешную передачу.
+  double mean_success_rounds() const;
+};
+
+// Сумма по всем потокам, включая завершившиеся. Обходит список блоков
+// без блокировок; значения, обновляемые в этот момент, могут не войти.
+Snapshot Collect();
+
+// Обнуляет все блоки; обновления, идущие одновременно, могут сохраниться.
+void Reset();
+
+// Текущее значение счётчика тактов: TSC на x86, иначе наносекунды.
+inline uint64_t ReadCycles() {
+#if HARQ_INSTRUMENTATION_RDTSC
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+namespace internal {
+
+// Раскладка ячеек блока потока.
+inline constexpr int kCounterSlot = 0;
+inline constexpr int kStatusSlot = kCounterSlot + kCounterCount;
+inline constexpr int kRoundSlot = kStatusSlot + kStatusCount;
+inline constexpr int kCyclesSlot = kRoundSlot + kRoundBins;
+inline constexpr int kCallsSlot = kCyclesSlot + kStageCount;
+inline constexpr int kSlotCount = kCallsSlot + kStageCount;
+
+// Блок счётчиков одного потока. Пишет только владелец (load + store без
+// атомарного RMW), читает Collect; блоки не освобождаются и переходят к
+// новым потокам после завершения владельца.
+struct alignas(64) ThreadBlock {
+  std::array<std::atomic<uint64_t>, kSlotCount> values{};
+  std::atomic<bool> in_use{false};
+  ThreadBlock* next = nullptr;
+};
+
+ThreadBlock* AcquireBlock();
+
+extern thread_local ThreadBlock* local_block;
+
+inline void Add(int slot, uint64_t value) {
+  ThreadBlock* block = local_block;
+  if (block == nullptr) {
+    block = AcquireBlock();
+  }
+  std::atomic<uint64_t>& cell = block->values[slot];
+  cell.store(cell.load(std::memory_order_relaxed) + value,
+             std::memory_order_relaxed);
+}
+
+}  // namespace internal
+
+inline void Count(Counter counter, uint64_t value = 1) {
+  internal::Add(internal::kCounterSlot + static_cast<int>(counter), value);
+}
+
+inline void CountStatus(int status) {
+  internal::Add(internal::kStatusSlot + status, 1);
+}
+
+inline void CountSuccessRounds(int rounds) {
+  const int bin = rounds < 1 ? 0 : std::min(rounds, kRoundBins) - 1;
+  internal::Add(internal::kRoundSlot + bin, 1);
+}
+
+// Добавляет такты от конструктора до деструктора к стадии.
+class ScopedCycles {
+ public:
+  explicit ScopedCycles(Stage stage) : stage_(stage), start_(ReadCycles()) {}
+  ~ScopedCycles() {
+    const int stage = static_cast<int>(stage_);
+    internal::Add(internal::kCyclesSlot + stage, ReadCycles() - start_);
+    internal::Add(internal::kCallsSlot + stage, 1);
+  }
+
+  ScopedCycles(const ScopedCycles&) = delete;
+  ScopedCycles& operator=(const ScopedCycles&) = delete;
+
+ private:
+  Stage stage_;
+  uint64_t start_;
+};
+
+}  // namespace harq::instrumentation
+
+#define HARQ_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define HARQ_INSTRUMENTATION_CONCAT(a, b) HARQ_INSTRUMENTATION_CONCAT_(a, b)
+
+#if HARQ_INSTRUMENTATION_ENABLED
+#define HARQ_COUNT(counter, value)                                     \
+  ::harq::instrumentation::Count(::harq::instrumentation::Counter::counter, \
+                                 (value))
+#define HARQ_COUNT_STATUS(status) \
+  ::harq::instrumentation::CountStatus(static_cast<int>(status))
+#define HARQ_COUNT_SUCCESS_ROUNDS(rounds) \
+  ::harq::instrumentation::CountSuccessRounds(rounds)
+#define HARQ_STAGE(stage)                                           \
+  ::harq::instrumentation::ScopedCycles HARQ_INSTRUMENTATION_CONCAT( \
+      harq_stage_, __LINE__)(::harq::instrumentation::Stage::stage)
+#else
+// sizeof не вычисляет аргумент, но помечает переменные использованными.
+#define HARQ_COUNT(counter, value) ((void)sizeof(value))
+#define HARQ_COUNT_STATUS(status) ((void)sizeof(status))
+#define HARQ_COUNT_SUCCESS_ROUNDS(rounds) ((void)sizeof(rounds))
+#define HARQ_STAGE(stage) ((void)0)
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace harq {
+
+// Равномерный квантователь LLR с насыщением: q = clamp(round(llr * scale),
+// -L, L), L = 2^(bits-1) - 1; отрицательные LLR, округлённые до 0,
+// получают уровень -1, поэтому жёсткое решение (q >= 0 — бит 1) не
+// меняется. Симметричный диапазон позволяет складывать повторы без
+// переполнения.
+class LlrQuantizer {
+ public:
+  // bits — от 2 до 16; scale — число уровней на единицу LLR.
+  LlrQuantizer(int bits, double scale);
+
+  int bits() const;
+  double scale() const;
+  // Наибольший уровень L.
+  int max_level() const;
+
+  int Quantize(double llr) const;
+  double Dequantize(int level) const;
+
+  // out[i] = Quantize(gain * llr[i]); gain позволяет квантовать принятые
+  // отсчёты сразу с коэффициентом 2/sigma^2. Вариант int8_t — для bits <= 8.
+  void Quantize(std::span<const double> llr, std::span<int8_t> out,
+                double gain = 1.0) const;
+  void Quantize(std::span<const double> llr, std::span<int16_t> out,
+                double gain = 1.0) const;
+
+ private:
+  int bits_;
+  double scale_;
+  int max_level_;
+};
+
+}  // namespace harq
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace harq {
+
+// Финализатор splitmix64: обратимое перемешивание 64-битного слова.
+inline uint64_t Mix64(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// Генератор xoshiro256++: 256 бит состояния, период 2^256 - 1.
+// Состояние выводится из (seed, stream) через splitmix64, поэтому выход
+// воспроизводим для заданной пары.
+class Xoshiro256 {
+ public:
+  explicit Xoshiro256(uint64_t seed, uint64_t stream = 0);
+
+  uint64_t Next();
+
+  // Равномерное число в [0, 1) с 53 значащими битами.
+  double NextDouble();
+
+  // Эквивалент 2^128 вызовов Next(): последовательные прыжки дают
+  // непересекающиеся подпоследовательности для параллельных потоков.
+  void Jump();
+
+ private:
+  uint64_t state_[4];
+};
+
+// Генератор нормального шума N(0, sigma^2) по методу зиккурата
+// (Marsaglia–Tsang, 128 слоёв): в ~99% случаев одно 64-битное число,
+// умножение и сравнение. Пишет сразу в буфер вызывающей стороны.
+class GaussianNoise {
+ public:
+  explicit GaussianNoise(uint64_t seed, uint64_t stream = 0);
+
+  // Один отсчёт N(0, 1).
+  double Next();
+
+  // Заполняет буфер отсчётами N(0, sigma^2).
+  void Fill(std::span<double> out, double sigma);
+  void Fill(std::span<float> out, float sigma);
+
+  // Добавляет шум N(0, sigma^2) на месте.
+  void AddTo(std::span<double> samples, double sigma);
+  void AddTo(std::span<float> samples, float sigma);
+
+  Xoshiro256& engine();
+
+ private:
+  double SampleSlow(uint64_t bits);
+
+  Xoshiro256 engine_;
+};
+
+// Поток шума канала: GaussianNoise с запомненными (seed, stream) и числом
+// сделанных Jump(). Fork выводит поток потомка из потока родителя и
+// номера child, поэтому он не совпадает ни с родителем (корневой поток —
+// 0), ни с потомками других потоков; прыжки родителя повторяются у
+// потомка. Результат воспроизводим для цепочки (seed, child, ...).
+class NoiseStream {
+ public:
+  explicit NoiseStream(uint64_t seed, uint64_t stream = 0);
+
+  NoiseStream Fork(uint64_t child) const;
+
+  // Сдвигает генератор на 2^128 отсчётов.
+  void Jump();
+
+  // Добавляет шум N(0, sigma^2) на месте.
+  void AddTo(std::span<double> samples, double sigma);
+
+ private:
+  uint64_t seed_;
+  uint64_t stream_;
+  uint64_t jumps_;
+  GaussianNoise noise_;
+};
+
+}  // namespace harq
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "chase_algorithm.hpp"
+
+namespace harq {
+
+// Неизменяемая таблица тестовых последовательностей алгоритма Чейза для
+// пары (n, d). Для First элементы — позиции кодового слова, для остальных
+// алгоритмов — ранги наименее надёжных позиций (ранг 0 — наименее надёжная);
+// в позиции ранги переводятся для каждого слова через индексы
+// SelectLeastReliable. Порядок последовательностей совпадает с
+// generate_probe_sequences_1/2/3 (ThirdNested — по возрастанию m).
+class ProbePatternTable {
+ public:
+  ProbePatternTable(int n, int d, ProbeAlgorithm algorithm);
+
+  int n() const;
+  int d() const;
+  ProbeAlgorithm algorithm() const;
+
+  // Число последовательностей.
+  int size() const;
+  // Сколько наименее надёжных позиций нужно для перевода рангов (0 для First).
+  int ranks() const;
+
+  // Позиции (First) или ранги (остальные алгоритмы) единиц
+  // последовательности.
+  std::span<const int> Pattern(int index) const;
+
+ private:
+  int n_;
+  int d_;
+  ProbeAlgorithm algorithm_;
+  int ranks_;
+  // Последовательность i — entries_[offsets_[i] .. offsets_[i + 1]).
+  std::vector<int> entries_;
+  std::vector<int> offsets_;
+};
+
+// Общий для процесса кэш таблиц: таблица строится при первом запросе
+// (n, d, algorithm) и дальше разделяется всеми потоками только для
+// чтения. Ошибочные параметры бросают std::invalid_argument.
+std::shared_ptr<const ProbePatternTable> GetProbePatterns(
+    int n, int d, ProbeAlgorithm algorithm);
+
+}  // namespace harq
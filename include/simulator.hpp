@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "chase_algorithm.hpp"
+
+namespace harq {
+
+// Схема приёма, для которой строится кривая BER/FER. kHarqChase —
+// повторные передачи с объединением по Чейзу, kHarqIr — инкрементная
+// избыточность (HarqProcess; всегда по расширенному коду).
+enum class Scheme {
+  kHardHamming,
+  kChase1,
+  kChase2,
+  kChase3,
+  kHarqChase,
+  kHarqIr
+};
+
+std::string SchemeName(Scheme scheme);
+
+struct SimulationConfig {
+  int r = 3;
+  // Расширенный код (n+1) с общим паритетом.
+  bool extended = false;
+  // Параметр d алгоритмов Чейза.
+  int chase_d = HAMMING_CODE_DISTANCE;
+
+  // Бюджет передач и декодер процесса HARQ.
+  int harq_max_rounds = 4;
+  ProbeAlgorithm harq_algorithm = ProbeAlgorithm::Second;
+
+  // Квантование LLR для схем Чейза и HARQ (см. LlrQuantizer): 0 — без
+  // квантования, иначе ширина в битах (для HARQ не больше 8) и число
+  // уровней на единицу LLR.
+  int llr_bits = 0;
+  double llr_scale = 4.0;
+
+  std::vector<Scheme> schemes = {Scheme::kHardHamming};
+  std::vector<double> snr_db;
+
+  // 0 — по числу аппаратных потоков.
+  int threads = 0;
+  // Кадров в одном пакете; пакет — единица работы потока.
+  int batch_frames = 256;
+  uint64_t max_frames = 1000000;
+  // Точка останавливается после target_frame_errors ошибочных кадров
+  // либо когда полуширина 95% доверительного интервала FER не превышает
+  // target_relative_ci * FER (0 — критерий отключён).
+  uint64_t target_frame_errors = 100;
+  double target_relative_ci = 0.0;
+
+  uint32_t seed = 5489u;
+};
+
+struct SimulationPoint {
+  Scheme scheme;
+  double snr_db;
+  uint64_t frames;
+  uint64_t frame_errors;
+  uint64_t bits;
+  uint64_t bit_errors;
+  // Переданные в канал символы с учётом повторов.
+  uint64_t channel_symbols;
+
+  double ber() const;
+  double fer() const;
+  // Доставленные информационные биты на символ канала.
+  double throughput() const;
+};
+
+// Monte-Carlo моделирование кодер -> BPSK -> АБГШ -> декодер по сетке SNR.
+// Потоки разбирают пакеты кадров из общего атомарного счётчика, поэтому
+// быстрые потоки забирают больше работы. Пакет b точки получает собственные
+// подпоследовательности генераторов, и результат без раннего останова не
+// зависит от числа потоков.
+class Simulator {
+ public:
+  explicit Simulator(SimulationConfig config);
+
+  const SimulationConfig& config() const;
+
+  // Все схемы по всей сетке SNR, в порядке config.schemes x config.snr_db.
+  std::vector<SimulationPoint> Run() const;
+
+  SimulationPoint RunPoint(Scheme scheme, double snr_db) const;
+
+ private:
+  SimulationConfig config_;
+  int threads_;
+};
+
+// Таблица CSV: scheme,snr_db,frames,frame_errors,fer,bits,bit_errors,ber,
+// throughput.
+void WriteCurves(std::ostream& out, const std::vector<SimulationPoint>& points);
+
+}  // namespace harq
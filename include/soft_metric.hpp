@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace harq {
+
+// Набор инструкций для векторных ядер; выбирается во время выполнения.
+enum class SimdLevel { kScalar, kSse41, kAvx2 };
+
+// Наилучший уровень, поддерживаемый процессором.
+SimdLevel DetectSimdLevel();
+
+// Корреляционная метрика кандидатов кадра: сумма |LLR| по позициям, где
+// бит кандидата расходится с жёстким решением (LLR >= 0 — бит 1).
+// candidates — metrics.size() строк по llr.size() битов 0/1 подряд.
+void ScoreCandidates(std::span<const double> llr,
+                     std::span<const uint8_t> candidates,
+                     std::span<double> metrics,
+                     SimdLevel level = DetectSimdLevel());
+
+void ScoreCandidates(std::span<const float> llr,
+                     std::span<const uint8_t> candidates,
+                     std::span<float> metrics,
+                     SimdLevel level = DetectSimdLevel());
+
+// Целочисленные LLR в диапазоне [-32767, 32767]; вдвое больше дорожек,
+// чем у float. Метрика накапливается в int32_t.
+void ScoreCandidates(std::span<const int16_t> llr,
+                     std::span<const uint8_t> candidates,
+                     std::span<int32_t> metrics,
+                     SimdLevel level = DetectSimdLevel());
+
+// LLR в int8_t (квантование до 8 битов): 32 дорожки AVX2.
+void ScoreCandidates(std::span<const int8_t> llr,
+                     std::span<const uint8_t> candidates,
+                     std::span<int32_t> metrics,
+                     SimdLevel level = DetectSimdLevel());
+
+// Объединение по Чейзу: acc[i] += scale * llr[i]. Буфер acc копит LLR
+// всех повторных передач; scale позволяет складывать принятые отсчёты
+// сразу с коэффициентом 2/sigma^2, без промежуточного буфера LLR.
+void AccumulateLlr(std::span<double> acc, std::span<const double> llr,
+                   double scale = 1.0, SimdLevel level = DetectSimdLevel());
+
+void AccumulateLlr(std::span<float> acc, std::span<const float> llr,
+                   float scale = 1.0f, SimdLevel level = DetectSimdLevel());
+
+// Объединение квантованных LLR с насыщением:
+// acc[i] = clamp(acc[i] + llr[i], -limit, limit), limit — наибольший
+// уровень квантователя.
+void AccumulateLlrSaturated(std::span<int8_t> acc, std::span<const int8_t> llr,
+                            int limit, SimdLevel level = DetectSimdLevel());
+
+void AccumulateLlrSaturated(std::span<int16_t> acc,
+                            std::span<const int16_t> llr, int limit,
+                            SimdLevel level = DetectSimdLevel());
+
+}  // namespace harq
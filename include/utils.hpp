@@ -1,8 +1,26 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 namespace harq {
 std::vector<size_t> get_n_smallest_indices(const std::vector<double> &values,
                                            int n);
-} // namespace harq
\ No newline at end of file
+
+// Наибольшее число позиций, выбираемых SelectLeastReliable.
+constexpr std::size_t kMaxLeastReliable = 64;
+
+// Записывает в out индексы out.size() (<= kMaxLeastReliable) наименьших
+// |values| по возрастанию, при равенстве — по возрастанию индекса. Один
+// проход без выделения памяти: отсортированный регистр кандидатов
+// обновляется без ветвлений, а значения не меньше текущего порога
+// отсеиваются сравнением (для double — по 4 за раз в AVX2).
+void SelectLeastReliable(std::span<const double> values,
+                         std::span<std::size_t> out);
+void SelectLeastReliable(std::span<const int8_t> values,
+                         std::span<std::size_t> out);
+void SelectLeastReliable(std::span<const int16_t> values,
+                         std::span<std::size_t> out);
+} // namespace harq
@@ -1,19 +1,37 @@
 #include "awgn_channel.hpp"
 
 #include <cmath>
-#include <random>
 #include <stdexcept>
 
+#include "carrier_oscillator.hpp"
+#include "instrumentation.hpp"
+
 namespace harq {
 
 namespace {
 double SnrDbToLinear(double snr_db) {
   return std::pow(10.0, snr_db / 10.0);
 }
+
+// Средняя мощность несущей: точно по периоду таблицы, для ротатора — по
+// kMaxTablePeriod отсчётам.
+double MeanCarrierPower(const BpskCarrierConfig& config) {
+  CarrierOscillator oscillator(config.carrier_hz, config.sample_rate_hz,
+                               config.phase);
+  std::vector<double> carrier(oscillator.tabulated()
+                                  ? oscillator.period()
+                                  : CarrierOscillator::kMaxTablePeriod);
+  oscillator.Generate(carrier);
+  double power = 0.0;
+  for (double value : carrier) {
+    power += value * value;
+  }
+  return power / static_cast<double>(carrier.size());
+}
 }  // namespace
 
 AwgnChannel::AwgnChannel(double snr_db, uint32_t seed)
-    : snr_db_(snr_db), sigma2_(0.0), sigma_(0.0), seed_(seed) {
+    : snr_db_(snr_db), sigma2_(0.0), sigma_(0.0), noise_(seed) {
   UpdateSigma();
 }
 
@@ -24,21 +42,19 @@ void AwgnChannel::SetSnrDb(double snr_db) {
 
 std::vector<double> AwgnChannel::AddNoise(
     const std::vector<double>& symbols) {
-  std::vector<double> received;
-  received.reserve(symbols.size());
-
-  std::mt19937 rng(seed_);
-  std::normal_distribution<double> dist(0.0, sigma_);
-
-  for (double symbol : symbols) {
-    received.push_back(symbol + dist(rng));
-  }
-
+  std::vector<double> received = symbols;
+  AddNoiseInPlace(received);
   return received;
 }
 
+void AwgnChannel::AddNoiseInPlace(std::span<double> symbols) {
+  HARQ_STAGE(kChannel);
+  noise_.AddTo(symbols, sigma_);
+}
+
 std::vector<double> AwgnChannel::ComputeLlr(
     const std::vector<double>& received) const {
+  HARQ_STAGE(kLlr);
   std::vector<double> llr;
   llr.reserve(received.size());
 
@@ -57,6 +73,18 @@ std::pair<std::vector<double>, std::vector<double>> AwgnChannel::Transmit(
   return {received, llr};
 }
 
+AwgnChannel AwgnChannel::Fork(uint64_t stream_id) const {
+  AwgnChannel child = *this;
+  child.noise_ = noise_.Fork(stream_id);
+  return child;
+}
+
+void AwgnChannel::Jump() { noise_.Jump(); }
+
+double AwgnChannel::snr_db() const { return snr_db_; }
+
+double AwgnChannel::noise_variance() const { return sigma2_; }
+
 void AwgnChannel::UpdateSigma() {
   if (!std::isfinite(snr_db_)) {
     throw std::invalid_argument("SNR must be finite.");
@@ -71,4 +99,50 @@ void AwgnChannel::UpdateSigma() {
   sigma_ = std::sqrt(sigma2_);
 }
 
+PassbandAwgnChannel::PassbandAwgnChannel(double ebn0_db,
+                                         const BpskCarrierConfig& config,
+                                         uint32_t seed)
+    : config_(config), ebn0_db_(ebn0_db), bit_energy_(0.0), sigma2_(0.0),
+      sigma_(0.0), noise_(seed) {
+  ValidateCarrierConfig(config);
+  bit_energy_ = config.amplitude * config.amplitude *
+                config.samples_per_symbol * MeanCarrierPower(config);
+  if (!std::isfinite(bit_energy_) || bit_energy_ <= 0.0) {
+    throw std::invalid_argument("Passband bit energy must be positive.");
+  }
+  UpdateSigma();
+}
+
+void PassbandAwgnChannel::SetEbN0Db(double ebn0_db) {
+  ebn0_db_ = ebn0_db;
+  UpdateSigma();
+}
+
+void PassbandAwgnChannel::AddNoiseInPlace(std::span<double> samples) {
+  HARQ_STAGE(kChannel);
+  noise_.AddTo(samples, sigma_);
+}
+
+PassbandAwgnChannel PassbandAwgnChannel::Fork(uint64_t stream_id) const {
+  PassbandAwgnChannel child = *this;
+  child.noise_ = noise_.Fork(stream_id);
+  return child;
+}
+
+void PassbandAwgnChannel::Jump() { noise_.Jump(); }
+
+double PassbandAwgnChannel::ebn0_db() const { return ebn0_db_; }
+
+double PassbandAwgnChannel::bit_energy() const { return bit_energy_; }
+
+double PassbandAwgnChannel::noise_variance() const { return sigma2_; }
+
+void PassbandAwgnChannel::UpdateSigma() {
+  if (!std::isfinite(ebn0_db_)) {
+    throw std::invalid_argument("Eb/N0 must be finite.");
+  }
+  sigma2_ = bit_energy_ / (2.0 * SnrDbToLinear(ebn0_db_));
+  sigma_ = std::sqrt(sigma2_);
+}
+
 }  // namespace harq
@@ -0,0 +1,69 @@
+#include "bit_packing.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace harq {
+
+void CopyBits(std::span<const uint64_t> src, std::size_t src_offset,
+              std::span<uint64_t> dst, std::size_t dst_offset,
+              std::size_t len) {
+  while (len > 0) {
+    const int chunk = static_cast<int>(std::min<std::size_t>(len, 64));
+    WriteBits(dst, dst_offset, chunk, ReadBits(src, src_offset, chunk));
+    src_offset += chunk;
+    dst_offset += chunk;
+    len -= chunk;
+  }
+}
+
+void Transpose64(std::span<uint64_t, 64> block) {
+  uint64_t mask = 0x00000000FFFFFFFFull;
+  for (int j = 32; j != 0; j >>= 1, mask ^= (mask << j)) {
+    for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+      const uint64_t t = ((block[k] >> j) ^ block[k | j]) & mask;
+      block[k | j] ^= t;
+      block[k] ^= t << j;
+    }
+  }
+}
+
+void PackBits(std::span<const uint8_t> bits, std::span<uint64_t> words) {
+  if (words.size() < PackedWordCount(bits.size())) {
+    throw std::invalid_argument("Packed buffer is too small.");
+  }
+
+  std::fill(words.begin(), words.end(), 0);
+  for (std::size_t i = 0; i < bits.size(); i++) {
+    const uint8_t bit = bits[i];
+    if (bit > 1) {
+      throw std::invalid_argument("Bit packing expects bits 0 or 1.");
+    }
+    words[i / 64] |= static_cast<uint64_t>(bit) << (i % 64);
+  }
+}
+
+std::vector<uint64_t> PackBits(const std::vector<uint8_t>& bits) {
+  std::vector<uint64_t> words(PackedWordCount(bits.size()), 0);
+  PackBits(std::span<const uint8_t>(bits), words);
+  return words;
+}
+
+void UnpackBits(std::span<const uint64_t> words, std::span<uint8_t> bits) {
+  if (words.size() < PackedWordCount(bits.size())) {
+    throw std::invalid_argument("Packed buffer is too small.");
+  }
+
+  for (std::size_t i = 0; i < bits.size(); i++) {
+    bits[i] = static_cast<uint8_t>((words[i / 64] >> (i % 64)) & 1);
+  }
+}
+
+std::vector<uint8_t> UnpackBits(const std::vector<uint64_t>& words,
+                                std::size_t bits) {
+  std::vector<uint8_t> result(bits, 0);
+  UnpackBits(std::span<const uint64_t>(words), result);
+  return result;
+}
+
+}  // namespace harq
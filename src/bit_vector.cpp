@@ -0,0 +1,144 @@
+#include "bit_vector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+#include "bit_packing.hpp"
+
+namespace harq {
+
+BitVector::BitVector() : size_(0), heap_words_(0), inline_{0, 0} {}
+
+BitVector::BitVector(std::size_t size) : BitVector() { Resize(size); }
+
+BitVector::BitVector(std::span<const uint8_t> bits) : BitVector(bits.size()) {
+  PackBits(bits, words());
+}
+
+BitVector::BitVector(const std::vector<uint8_t>& bits)
+    : BitVector(std::span<const uint8_t>(bits)) {}
+
+BitVector::BitVector(const BitVector& other) : BitVector(other.size_) {
+  std::copy_n(other.data(), other.word_count(), data());
+}
+
+BitVector& BitVector::operator=(const BitVector& other) {
+  if (this != &other) {
+    Resize(other.size_);
+    std::copy_n(other.data(), other.word_count(), data());
+  }
+  return *this;
+}
+
+BitVector::BitVector(BitVector&& other) noexcept
+    : size_(std::exchange(other.size_, 0)),
+      heap_words_(std::exchange(other.heap_words_, 0)),
+      heap_(std::move(other.heap_)),
+      inline_{other.inline_[0], other.inline_[1]} {
+  other.inline_[0] = 0;
+  other.inline_[1] = 0;
+}
+
+BitVector& BitVector::operator=(BitVector&& other) noexcept {
+  if (this != &other) {
+    size_ = std::exchange(other.size_, 0);
+    heap_words_ = std::exchange(other.heap_words_, 0);
+    heap_ = std::move(other.heap_);
+    std::copy_n(other.inline_, kInlineWords, inline_);
+    std::fill_n(other.inline_, kInlineWords, 0);
+  }
+  return *this;
+}
+
+void BitVector::Set(std::size_t index, int bit) {
+  const uint64_t mask = uint64_t{1} << (index % 64);
+  uint64_t& word = data()[index / 64];
+  word = bit ? (word | mask) : (word & ~mask);
+}
+
+void BitVector::Resize(std::size_t size) {
+  const std::size_t words = PackedWordCount(size);
+  if (words > capacity_words()) {
+    // Рост в 2 раза: PushBack в цикле даёт амортизированное O(1).
+    const std::size_t capacity = std::max(words, 2 * capacity_words());
+    std::unique_ptr<uint64_t[]> grown(new uint64_t[capacity]());
+    std::copy_n(data(), word_count(), grown.get());
+    heap_ = std::move(grown);
+    heap_words_ = capacity;
+  }
+  const std::size_t old_words = word_count();
+  size_ = size;
+  if (words > old_words) {
+    std::fill(data() + old_words, data() + words, 0);
+  }
+  ClearTail();
+}
+
+void BitVector::PushBack(int bit) {
+  Resize(size_ + 1);
+  Set(size_ - 1, bit);
+}
+
+std::size_t BitVector::Popcount() const {
+  std::size_t count = 0;
+  for (uint64_t word : words()) {
+    count += std::popcount(word);
+  }
+  return count;
+}
+
+BitVector& BitVector::operator^=(const BitVector& other) {
+  if (other.size_ != size_) {
+    throw std::invalid_argument("Bit vector sizes must match.");
+  }
+  uint64_t* dst = data();
+  const uint64_t* src = other.data();
+  for (std::size_t w = 0; w < word_count(); w++) {
+    dst[w] ^= src[w];
+  }
+  return *this;
+}
+
+bool BitVector::operator==(const BitVector& other) const {
+  return size_ == other.size_ &&
+         std::equal(data(), data() + word_count(), other.data());
+}
+
+BitVector BitVector::Gather(std::span<const int> positions) const {
+  BitVector result(positions.size());
+  uint64_t* out = result.data();
+  for (std::size_t i = 0; i < positions.size(); i++) {
+    out[i / 64] |= static_cast<uint64_t>(Get(positions[i])) << (i % 64);
+  }
+  return result;
+}
+
+void BitVector::Scatter(std::span<const int> positions,
+                        const BitVector& values) {
+  if (values.size() != positions.size()) {
+    throw std::invalid_argument("Scatter expects one bit per position.");
+  }
+  for (std::size_t i = 0; i < positions.size(); i++) {
+    Set(positions[i], values.Get(i));
+  }
+}
+
+std::vector<uint8_t> BitVector::ToBytes() const {
+  std::vector<uint8_t> bits(size_);
+  UnpackBits(words(), bits);
+  return bits;
+}
+
+std::size_t BitVector::capacity_words() const {
+  return heap_ ? heap_words_ : kInlineWords;
+}
+
+void BitVector::ClearTail() {
+  if (size_ % 64 != 0) {
+    data()[size_ / 64] &= LowBitsMask(static_cast<int>(size_ % 64));
+  }
+}
+
+}  // namespace harq
@@ -1,24 +1,260 @@
 #include "bpsk.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <stdexcept>
 
+#include "bit_packing.hpp"
+#include "simd_dispatch.hpp"
+
 namespace harq {
 
-std::vector<double> BpskModulator::Modulate(
-    const std::vector<uint8_t>& bits) const {
-  std::vector<double> symbols;
-  symbols.reserve(bits.size());
+namespace {
 
-  for (uint8_t bit : bits) {
-    if (bit == 0) {
-      symbols.push_back(-1.0);
-    } else if (bit == 1) {
-      symbols.push_back(1.0);
-    } else {
-      throw std::invalid_argument("BPSK modulator expects bits 0 or 1.");
+void CheckSizes(std::size_t bits, std::size_t symbols) {
+  if (bits != symbols) {
+    throw std::invalid_argument("BPSK bit and symbol counts must match.");
+  }
+}
+
+void CheckPackedSize(std::size_t words, std::size_t symbols) {
+  if (words < PackedWordCount(symbols)) {
+    throw std::invalid_argument("Packed BPSK buffer is too small.");
+  }
+}
+
+#if defined(HARQ_X86_SIMD)
+
+// Байт j элемента m равен биту j числа m: маска знаков из 4 дорожек
+// раскладывается в 4 байта 0/1 одной записью.
+constexpr std::array<uint32_t, 16> MakeNibbleBytes() {
+  std::array<uint32_t, 16> table{};
+  for (uint32_t m = 0; m < 16; m++) {
+    for (int j = 0; j < 4; j++) {
+      table[m] |= ((m >> j) & 1u) << (8 * j);
     }
   }
+  return table;
+}
+
+constexpr std::array<uint32_t, 16> kNibbleBytes = MakeNibbleBytes();
+
+__attribute__((target("avx2"))) std::size_t MapAvx2(const uint8_t* bits,
+                                                    double* symbols,
+                                                    std::size_t n) {
+  const __m256d one = _mm256_set1_pd(1.0);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    uint32_t chunk;
+    std::memcpy(&chunk, bits + i, sizeof(chunk));
+    const __m256d b = _mm256_cvtepi32_pd(
+        _mm_cvtepu8_epi32(_mm_cvtsi32_si128(static_cast<int>(chunk))));
+    _mm256_storeu_pd(symbols + i, _mm256_sub_pd(_mm256_add_pd(b, b), one));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t MapAvx2(const uint8_t* bits,
+                                                    float* symbols,
+                                                    std::size_t n) {
+  const __m256 one = _mm256_set1_ps(1.0f);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 b = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(bits + i))));
+    _mm256_storeu_ps(symbols + i, _mm256_sub_ps(_mm256_add_ps(b, b), one));
+  }
+  return i;
+}
+
+// Группа битов размножается по дорожкам, каждая дорожка выделяет свой
+// бит сравнением с маской, результат сравнения выбирает 2.0 или 0.0.
+__attribute__((target("avx2"))) std::size_t MapPackedAvx2(
+    const uint64_t* words, double* symbols, std::size_t n) {
+  const __m256i select = _mm256_setr_epi64x(1, 2, 4, 8);
+  const __m256d two = _mm256_set1_pd(2.0);
+  const __m256d one = _mm256_set1_pd(1.0);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const uint64_t nibble = (words[i / 64] >> (i % 64)) & 0xF;
+    const __m256i lanes = _mm256_and_si256(
+        _mm256_set1_epi64x(static_cast<int64_t>(nibble)), select);
+    const __m256d set =
+        _mm256_castsi256_pd(_mm256_cmpeq_epi64(lanes, select));
+    _mm256_storeu_pd(symbols + i, _mm256_sub_pd(_mm256_and_pd(set, two), one));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t MapPackedAvx2(
+    const uint64_t* words, float* symbols, std::size_t n) {
+  const __m256i select = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  const __m256 two = _mm256_set1_ps(2.0f);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const uint64_t byte = (words[i / 64] >> (i % 64)) & 0xFF;
+    const __m256i lanes = _mm256_and_si256(
+        _mm256_set1_epi32(static_cast<int>(byte)), select);
+    const __m256 set = _mm256_castsi256_ps(_mm256_cmpeq_epi32(lanes, select));
+    _mm256_storeu_ps(symbols + i, _mm256_sub_ps(_mm256_and_ps(set, two), one));
+  }
+  return i;
+}
+
+// Маски знаков: сравнение >= 0 (а не знаковый бит), чтобы -0.0 давал 1,
+// как в скалярном пути.
+__attribute__((target("avx2"))) uint32_t SignMask4(const double* symbols) {
+  return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(
+      _mm256_loadu_pd(symbols), _mm256_setzero_pd(), _CMP_GE_OQ)));
+}
+
+__attribute__((target("avx2"))) uint32_t SignMask8(const float* symbols) {
+  return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(
+      _mm256_loadu_ps(symbols), _mm256_setzero_ps(), _CMP_GE_OQ)));
+}
+
+__attribute__((target("avx2"))) std::size_t DemapAvx2(const double* symbols,
+                                                      uint8_t* bits,
+                                                      std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    std::memcpy(bits + i, &kNibbleBytes[SignMask4(symbols + i)], 4);
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t DemapAvx2(const float* symbols,
+                                                      uint8_t* bits,
+                                                      std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const uint32_t mask = SignMask8(symbols + i);
+    std::memcpy(bits + i, &kNibbleBytes[mask & 0xF], 4);
+    std::memcpy(bits + i + 4, &kNibbleBytes[mask >> 4], 4);
+  }
+  return i;
+}
+
+// Слова должны быть обнулены: маски дописываются через |=.
+__attribute__((target("avx2"))) std::size_t DemapPackedAvx2(
+    const double* symbols, uint64_t* words, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    words[i / 64] |= uint64_t{SignMask4(symbols + i)} << (i % 64);
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t DemapPackedAvx2(
+    const float* symbols, uint64_t* words, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    words[i / 64] |= uint64_t{SignMask8(symbols + i)} << (i % 64);
+  }
+  return i;
+}
+
+#endif
+
+template <typename T>
+void MapAll(std::span<const uint8_t> bits, std::span<T> symbols,
+            SimdLevel level) {
+  CheckSizes(bits.size(), symbols.size());
+  std::size_t i = 0;
+#if defined(HARQ_X86_SIMD)
+  if (UseAvx2(level)) {
+    i = MapAvx2(bits.data(), symbols.data(), bits.size());
+  }
+#else
+  (void)level;
+#endif
+  for (; i < bits.size(); i++) {
+    symbols[i] = T(2) * static_cast<T>(bits[i]) - T(1);
+  }
+}
+
+template <typename T>
+void MapPackedAll(std::span<const uint64_t> words, std::span<T> symbols,
+                  SimdLevel level) {
+  CheckPackedSize(words.size(), symbols.size());
+  std::size_t i = 0;
+#if defined(HARQ_X86_SIMD)
+  if (UseAvx2(level)) {
+    i = MapPackedAvx2(words.data(), symbols.data(), symbols.size());
+  }
+#else
+  (void)level;
+#endif
+  for (; i < symbols.size(); i++) {
+    symbols[i] = T(2) * static_cast<T>((words[i / 64] >> (i % 64)) & 1) - T(1);
+  }
+}
 
+template <typename T>
+void DemapAll(std::span<const T> symbols, std::span<uint8_t> bits,
+              SimdLevel level) {
+  CheckSizes(bits.size(), symbols.size());
+  std::size_t i = 0;
+#if defined(HARQ_X86_SIMD)
+  if (UseAvx2(level)) {
+    i = DemapAvx2(symbols.data(), bits.data(), symbols.size());
+  }
+#else
+  (void)level;
+#endif
+  for (; i < symbols.size(); i++) {
+    bits[i] = static_cast<uint8_t>(symbols[i] >= T(0));
+  }
+}
+
+template <typename T>
+void DemapPackedAll(std::span<const T> symbols, std::span<uint64_t> words,
+                    SimdLevel level) {
+  CheckPackedSize(words.size(), symbols.size());
+  const std::size_t used = PackedWordCount(symbols.size());
+  std::fill(words.begin(), words.begin() + used, uint64_t{0});
+  std::size_t i = 0;
+#if defined(HARQ_X86_SIMD)
+  if (UseAvx2(level)) {
+    i = DemapPackedAvx2(symbols.data(), words.data(), symbols.size());
+  }
+#else
+  (void)level;
+#endif
+  for (; i < symbols.size(); i++) {
+    words[i / 64] |= uint64_t{symbols[i] >= T(0)} << (i % 64);
+  }
+}
+
+template <typename T>
+void DemapSoftAll(std::span<T> symbols, T noise_variance) {
+  if (!(noise_variance > T(0))) {
+    throw std::invalid_argument("Noise variance must be positive.");
+  }
+  // Простой цикл компилятор векторизует сам.
+  const T scale = T(2) / noise_variance;
+  for (T& value : symbols) {
+    value *= scale;
+  }
+}
+
+}  // namespace
+
+std::vector<double> BpskModulator::Modulate(
+    const std::vector<uint8_t>& bits) const {
+  ValidateBits(bits);
+  std::vector<double> symbols(bits.size());
+  BpskMap(bits, symbols);
+  return symbols;
+}
+
+std::vector<double> BpskModulator::Modulate(const BitVector& bits) const {
+  // Биты упакованного вектора всегда 0/1, проверка не нужна.
+  std::vector<double> symbols(bits.size());
+  BpskMapPacked(bits.words(), symbols);
   return symbols;
 }
 
@@ -26,15 +262,14 @@ std::vector<double> BpskModulate(const std::vector<uint8_t>& bits) {
   return BpskModulator{}.Modulate(bits);
 }
 
+std::vector<double> BpskModulate(const BitVector& bits) {
+  return BpskModulator{}.Modulate(bits);
+}
+
 std::vector<uint8_t> BpskDemodulator::Demodulate(
     const std::vector<double>& symbols) const {
-  std::vector<uint8_t> bits;
-  bits.reserve(symbols.size());
-
-  for (double symbol : symbols) {
-    bits.push_back(symbol >= 0.0 ? 1 : 0);
-  }
-
+  std::vector<uint8_t> bits(symbols.size());
+  BpskDemap(symbols, bits);
   return bits;
 }
 
@@ -42,4 +277,63 @@ std::vector<uint8_t> BpskDemodulate(const std::vector<double>& symbols) {
   return BpskDemodulator{}.Demodulate(symbols);
 }
 
+void ValidateBits(std::span<const uint8_t> bits) {
+  // Без раннего выхода: OR по всем байтам векторизуется.
+  uint8_t high = 0;
+  for (uint8_t bit : bits) {
+    high |= bit & 0xFE;
+  }
+  if (high != 0) {
+    throw std::invalid_argument("BPSK modulator expects bits 0 or 1.");
+  }
+}
+
+void BpskMap(std::span<const uint8_t> bits, std::span<double> symbols,
+             SimdLevel level) {
+  MapAll(bits, symbols, level);
+}
+
+void BpskMap(std::span<const uint8_t> bits, std::span<float> symbols,
+             SimdLevel level) {
+  MapAll(bits, symbols, level);
+}
+
+void BpskMapPacked(std::span<const uint64_t> words, std::span<double> symbols,
+                   SimdLevel level) {
+  MapPackedAll(words, symbols, level);
+}
+
+void BpskMapPacked(std::span<const uint64_t> words, std::span<float> symbols,
+                   SimdLevel level) {
+  MapPackedAll(words, symbols, level);
+}
+
+void BpskDemap(std::span<const double> symbols, std::span<uint8_t> bits,
+               SimdLevel level) {
+  DemapAll(symbols, bits, level);
+}
+
+void BpskDemap(std::span<const float> symbols, std::span<uint8_t> bits,
+               SimdLevel level) {
+  DemapAll(symbols, bits, level);
+}
+
+void BpskDemapPacked(std::span<const double> symbols,
+                     std::span<uint64_t> words, SimdLevel level) {
+  DemapPackedAll(symbols, words, level);
+}
+
+void BpskDemapPacked(std::span<const float> symbols, std::span<uint64_t> words,
+                     SimdLevel level) {
+  DemapPackedAll(symbols, words, level);
+}
+
+void BpskDemapSoft(std::span<double> symbols, double noise_variance) {
+  DemapSoftAll(symbols, noise_variance);
+}
+
+void BpskDemapSoft(std::span<float> symbols, float noise_variance) {
+  DemapSoftAll(symbols, noise_variance);
+}
+
 }  // namespace harq
@@ -1,13 +1,12 @@
 #include "bpsk_passband.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
-namespace harq {
-
-namespace {
+#include "simd_dispatch.hpp"
 
-constexpr double kTwoPi = 6.2831853071795864769;
+namespace harq {
 
 void ValidateCarrierConfig(const BpskCarrierConfig& config) {
   if (!std::isfinite(config.carrier_hz) ||
@@ -26,10 +25,76 @@ void ValidateCarrierConfig(const BpskCarrierConfig& config) {
   }
 }
 
-double CarrierAt(const BpskCarrierConfig& config, std::size_t sample_index) {
-  const double t =
-      static_cast<double>(sample_index) / config.sample_rate_hz;
-  return std::cos(kTwoPi * config.carrier_hz * t + config.phase);
+namespace {
+
+// Для списков инициализации: несущая строится уже по проверенной
+// конфигурации.
+const BpskCarrierConfig& Validated(const BpskCarrierConfig& config) {
+  ValidateCarrierConfig(config);
+  return config;
+}
+
+// Суммы интегратора по отрезку символа.
+struct Correlation {
+  double signal = 0.0;
+  double carrier_energy = 0.0;
+  double sample_energy = 0.0;
+};
+
+Correlation IntegrateScalar(const double* samples, const double* carrier,
+                            std::size_t n) {
+  Correlation sums;
+  for (std::size_t i = 0; i < n; i++) {
+    sums.signal += samples[i] * carrier[i];
+    sums.carrier_energy += carrier[i] * carrier[i];
+    sums.sample_energy += samples[i] * samples[i];
+  }
+  return sums;
+}
+
+#if defined(HARQ_X86_SIMD)
+
+constexpr std::size_t kMinAvx2Run = 8;
+
+__attribute__((target("avx2"))) double HorizontalSum(__m256d value) {
+  const __m128d low = _mm256_castpd256_pd128(value);
+  const __m128d high = _mm256_extractf128_pd(value, 1);
+  const __m128d pair = _mm_add_pd(low, high);
+  return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+__attribute__((target("avx2"))) Correlation IntegrateAvx2(
+    const double* samples, const double* carrier, std::size_t n) {
+  __m256d signal = _mm256_setzero_pd();
+  __m256d carrier_energy = _mm256_setzero_pd();
+  __m256d sample_energy = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d x = _mm256_loadu_pd(samples + i);
+    const __m256d c = _mm256_loadu_pd(carrier + i);
+    signal = _mm256_add_pd(signal, _mm256_mul_pd(x, c));
+    carrier_energy = _mm256_add_pd(carrier_energy, _mm256_mul_pd(c, c));
+    sample_energy = _mm256_add_pd(sample_energy, _mm256_mul_pd(x, x));
+  }
+  Correlation sums = IntegrateScalar(samples + i, carrier + i, n - i);
+  sums.signal += HorizontalSum(signal);
+  sums.carrier_energy += HorizontalSum(carrier_energy);
+  sums.sample_energy += HorizontalSum(sample_energy);
+  return sums;
+}
+
+#endif
+
+Correlation Integrate(const double* samples, const double* carrier,
+                      std::size_t n, SimdLevel level) {
+#if defined(HARQ_X86_SIMD)
+  // На коротких отрезках свёртка регистров дороже самих сумм.
+  if (UseAvx2(level) && n >= kMinAvx2Run) {
+    return IntegrateAvx2(samples, carrier, n);
+  }
+#endif
+  (void)level;
+  return IntegrateScalar(samples, carrier, n);
 }
 
 }  // namespace
@@ -43,21 +108,8 @@ std::vector<double> BpskPassbandModulator::Modulate(
     const std::vector<uint8_t>& bits) const {
   ValidateCarrierConfig(config_);
 
-  std::vector<double> samples;
-  samples.reserve(bits.size() * config_.samples_per_symbol);
-
-  std::size_t sample_index = 0;
-  for (uint8_t bit : bits) {
-    const double symbol = (bit == 0) ? -1.0 : (bit == 1 ? 1.0 : 0.0);
-    if (symbol == 0.0) {
-      throw std::invalid_argument("BPSK passband modulator expects bits 0 or 1.");
-    }
-    for (int k = 0; k < config_.samples_per_symbol; ++k) {
-      const double carrier = CarrierAt(config_, sample_index++);
-      samples.push_back(config_.amplitude * symbol * carrier);
-    }
-  }
-
+  std::vector<double> samples(bits.size() * config_.samples_per_symbol);
+  BpskPassbandStreamModulator(config_).Process(bits, samples);
   return samples;
 }
 
@@ -77,26 +129,200 @@ std::vector<uint8_t> BpskPassbandDemodulator::Demodulate(
         "Sample count must be a multiple of samples per symbol.");
   }
 
-  const std::size_t symbols_count =
-      samples.size() / static_cast<std::size_t>(config_.samples_per_symbol);
-  std::vector<uint8_t> bits;
-  bits.reserve(symbols_count);
+  BpskPassbandStreamDemodulator demodulator(config_);
+  std::vector<uint8_t> bits(demodulator.SymbolsFor(samples.size()));
+  demodulator.Process(samples, bits);
+  return bits;
+}
+
+BpskPassbandStreamModulator::BpskPassbandStreamModulator(
+    BpskCarrierConfig config)
+    : config_(Validated(config)),
+      carrier_(config.carrier_hz, config.sample_rate_hz, config.phase) {}
 
-  std::size_t sample_index = 0;
-  for (std::size_t symbol_index = 0; symbol_index < symbols_count;
-       ++symbol_index) {
-    double accum = 0.0;
-    for (int k = 0; k < config_.samples_per_symbol; ++k) {
-      const double carrier = CarrierAt(config_, sample_index);
-      accum += samples[sample_index] * carrier;
-      ++sample_index;
+void BpskPassbandStreamModulator::Process(std::span<const uint8_t> bits,
+                                          std::span<double> samples) {
+  const std::size_t sps = static_cast<std::size_t>(config_.samples_per_symbol);
+  if (samples.size() != bits.size() * sps) {
+    throw std::invalid_argument(
+        "Passband modulator expects samples_per_symbol samples per bit.");
+  }
+  for (uint8_t bit : bits) {
+    if (bit > 1) {
+      throw std::invalid_argument(
+          "BPSK passband modulator expects bits 0 or 1.");
     }
-    bits.push_back(accum >= 0.0 ? 1 : 0);
   }
 
-  return bits;
+  // Несущая генерируется сразу на весь блок и умножается на символы.
+  carrier_.Generate(samples);
+  for (std::size_t i = 0; i < bits.size(); i++) {
+    const double gain = config_.amplitude * (2.0 * bits[i] - 1.0);
+    for (std::size_t k = i * sps; k < (i + 1) * sps; k++) {
+      samples[k] *= gain;
+    }
+  }
 }
 
+void BpskPassbandStreamModulator::Reset() { carrier_.Reset(); }
+
+uint64_t BpskPassbandStreamModulator::position() const {
+  return carrier_.position();
+}
+
+BpskPassbandStreamDemodulator::BpskPassbandStreamDemodulator(
+    BpskCarrierConfig config)
+    : config_(Validated(config)),
+      oscillator_(config.carrier_hz, config.sample_rate_hz, config.phase),
+      carrier_(kCarrierBlock), accum_(0.0), filled_(0) {}
+
+std::size_t BpskPassbandStreamDemodulator::SymbolsFor(
+    std::size_t samples) const {
+  return (static_cast<std::size_t>(filled_) + samples) /
+         static_cast<std::size_t>(config_.samples_per_symbol);
+}
+
+std::size_t BpskPassbandStreamDemodulator::Process(
+    std::span<const double> samples, std::span<uint8_t> bits) {
+  if (bits.size() < SymbolsFor(samples.size())) {
+    throw std::invalid_argument("Passband demodulator output is too small.");
+  }
+
+  const int sps = config_.samples_per_symbol;
+  std::size_t produced = 0;
+  std::size_t offset = 0;
+  while (offset < samples.size()) {
+    const std::size_t block =
+        std::min(carrier_.size(), samples.size() - offset);
+    oscillator_.Generate(std::span<double>(carrier_).first(block));
+
+    // Интегрирование со сбросом: отрезок до конца текущего символа.
+    std::size_t i = 0;
+    while (i < block) {
+      const std::size_t run =
+          std::min(static_cast<std::size_t>(sps - filled_), block - i);
+      double accum = accum_;
+      for (std::size_t j = 0; j < run; j++) {
+        accum += samples[offset + i + j] * carrier_[i + j];
+      }
+      accum_ = accum;
+      filled_ += static_cast<int>(run);
+      i += run;
+      if (filled_ == sps) {
+        bits[produced++] = accum_ >= 0.0 ? 1 : 0;
+        accum_ = 0.0;
+        filled_ = 0;
+      }
+    }
+    offset += block;
+  }
+  return produced;
+}
+
+void BpskPassbandStreamDemodulator::Reset() {
+  oscillator_.Reset();
+  accum_ = 0.0;
+  filled_ = 0;
+}
+
+int BpskPassbandStreamDemodulator::pending_samples() const { return filled_; }
+
+BpskPassbandSoftDemodulator::BpskPassbandSoftDemodulator(
+    BpskCarrierConfig config, double noise_variance)
+    : config_(Validated(config)),
+      oscillator_(config.carrier_hz, config.sample_rate_hz, config.phase),
+      carrier_(BpskPassbandStreamDemodulator::kCarrierBlock),
+      fixed_variance_(noise_variance), level_(DetectSimdLevel()),
+      correlation_(0.0), carrier_energy_(0.0), sample_energy_(0.0),
+      filled_(0), residual_energy_(0.0), residual_samples_(0) {
+  if (!std::isfinite(noise_variance) || noise_variance < 0.0) {
+    throw std::invalid_argument("Noise variance must be non-negative.");
+  }
+}
+
+std::size_t BpskPassbandSoftDemodulator::SymbolsFor(
+    std::size_t samples) const {
+  return (static_cast<std::size_t>(filled_) + samples) /
+         static_cast<std::size_t>(config_.samples_per_symbol);
+}
+
+std::size_t BpskPassbandSoftDemodulator::Process(
+    std::span<const double> samples, std::span<double> llr) {
+  if (llr.size() < SymbolsFor(samples.size())) {
+    throw std::invalid_argument("Passband demodulator output is too small.");
+  }
+
+  const int sps = config_.samples_per_symbol;
+  const double amplitude = config_.amplitude;
+  std::size_t produced = 0;
+  std::size_t offset = 0;
+  while (offset < samples.size()) {
+    const std::size_t block =
+        std::min(carrier_.size(), samples.size() - offset);
+    oscillator_.Generate(std::span<double>(carrier_).first(block));
+
+    std::size_t i = 0;
+    while (i < block) {
+      const std::size_t run =
+          std::min(static_cast<std::size_t>(sps - filled_), block - i);
+      const Correlation sums =
+          Integrate(samples.data() + offset + i, carrier_.data() + i, run,
+                    level_);
+      correlation_ += sums.signal;
+      carrier_energy_ += sums.carrier_energy;
+      sample_energy_ += sums.sample_energy;
+      filled_ += static_cast<int>(run);
+      i += run;
+      if (filled_ < sps) {
+        continue;
+      }
+
+      if (fixed_variance_ == 0.0) {
+        // Σ (r - A ŝ c)² = Σ r² - 2 A |y| + A² Σ c².
+        const double residual = sample_energy_ -
+                                2.0 * amplitude * std::abs(correlation_) +
+                                amplitude * amplitude * carrier_energy_;
+        residual_energy_ += std::max(residual, 0.0);
+        residual_samples_ += static_cast<uint64_t>(sps);
+      }
+      llr[produced++] = 2.0 * amplitude * correlation_ / noise_variance();
+      correlation_ = 0.0;
+      carrier_energy_ = 0.0;
+      sample_energy_ = 0.0;
+      filled_ = 0;
+    }
+    offset += block;
+  }
+  return produced;
+}
+
+double BpskPassbandSoftDemodulator::noise_variance() const {
+  if (fixed_variance_ > 0.0) {
+    return fixed_variance_;
+  }
+  // Без шума оценка нулевая; нижняя граница держит LLR конечными.
+  constexpr double kMinVariance = 1e-12;
+  return residual_samples_ == 0
+             ? 1.0
+             : std::max(residual_energy_ / residual_samples_, kMinVariance);
+}
+
+bool BpskPassbandSoftDemodulator::estimates_noise() const {
+  return fixed_variance_ == 0.0;
+}
+
+void BpskPassbandSoftDemodulator::Reset() {
+  oscillator_.Reset();
+  correlation_ = 0.0;
+  carrier_energy_ = 0.0;
+  sample_energy_ = 0.0;
+  filled_ = 0;
+  residual_energy_ = 0.0;
+  residual_samples_ = 0;
+}
+
+int BpskPassbandSoftDemodulator::pending_samples() const { return filled_; }
+
 std::vector<double> BpskPassbandModulate(
     const std::vector<uint8_t>& bits,
     BpskCarrierConfig config) {
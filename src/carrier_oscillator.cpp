@@ -0,0 +1,115 @@
+#include "carrier_oscillator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace harq {
+
+namespace {
+
+constexpr double kTwoPi = 6.2831853071795864769;
+// Допуск, с которым f * P / fs считается целым.
+constexpr double kRationalTolerance = 1e-9;
+
+}  // namespace
+
+CarrierOscillator::CarrierOscillator(double carrier_hz, double sample_rate_hz,
+                                     double phase)
+    : carrier_hz_(carrier_hz), sample_rate_hz_(sample_rate_hz),
+      phase_(phase), position_(0), table_index_(0), re_(0.0), im_(0.0),
+      step_re_(1.0), step_im_(0.0), since_renorm_(0) {
+  if (!std::isfinite(carrier_hz) || !std::isfinite(sample_rate_hz) ||
+      !std::isfinite(phase)) {
+    throw std::invalid_argument("BPSK carrier config must be finite.");
+  }
+  if (sample_rate_hz <= 0.0) {
+    throw std::invalid_argument("Sample rate must be positive.");
+  }
+
+  // Наименьший период P, на котором укладывается целое число m периодов
+  // несущей; фаза отсчёта i — 2π (i m mod P) / P, без накопления ошибки.
+  const double cycles_per_sample = carrier_hz / sample_rate_hz;
+  for (std::size_t period = 1; period <= kMaxTablePeriod; period++) {
+    const double cycles = cycles_per_sample * static_cast<double>(period);
+    const double whole = std::round(cycles);
+    if (std::abs(cycles - whole) <=
+        kRationalTolerance * std::max(1.0, std::abs(whole))) {
+      const int64_t m = static_cast<int64_t>(whole);
+      const int64_t length = static_cast<int64_t>(period);
+      table_.resize(period);
+      for (int64_t i = 0; i < length; i++) {
+        const int64_t step = ((i * m) % length + length) % length;
+        table_[i] = std::cos(
+            kTwoPi * static_cast<double>(step) / static_cast<double>(length) +
+            phase_);
+      }
+      return;
+    }
+  }
+
+  const double omega = kTwoPi * cycles_per_sample;
+  step_re_ = std::cos(omega);
+  step_im_ = std::sin(omega);
+  Reset();
+}
+
+void CarrierOscillator::Generate(std::span<double> out) {
+  if (!table_.empty()) {
+    // Копируем таблицу отрезками до конца периода.
+    std::size_t done = 0;
+    while (done < out.size()) {
+      const std::size_t run =
+          std::min(out.size() - done, table_.size() - table_index_);
+      std::copy_n(table_.begin() + table_index_, run, out.begin() + done);
+      done += run;
+      table_index_ = (table_index_ + run) % table_.size();
+    }
+    position_ += out.size();
+    return;
+  }
+
+  double re = re_;
+  double im = im_;
+  for (double& value : out) {
+    value = re;
+    const double next_re = re * step_re_ - im * step_im_;
+    im = re * step_im_ + im * step_re_;
+    re = next_re;
+    if (++since_renorm_ == kRenormInterval) {
+      re_ = re;
+      im_ = im;
+      Renormalize();
+      re = re_;
+      im = im_;
+    }
+  }
+  re_ = re;
+  im_ = im;
+  position_ += out.size();
+}
+
+void CarrierOscillator::Reset() {
+  position_ = 0;
+  table_index_ = 0;
+  re_ = std::cos(phase_);
+  im_ = std::sin(phase_);
+  since_renorm_ = 0;
+}
+
+uint64_t CarrierOscillator::position() const { return position_; }
+
+std::size_t CarrierOscillator::period() const { return table_.size(); }
+
+bool CarrierOscillator::tabulated() const { return !table_.empty(); }
+
+void CarrierOscillator::Renormalize() {
+  // Один шаг Ньютона для 1/|z|: ошибка модуля за kRenormInterval шагов
+  // порядка 1e-14, поправка (3 - |z|^2) / 2 возвращает её к округлению.
+  const double gain = 0.5 * (3.0 - (re_ * re_ + im_ * im_));
+  re_ *= gain;
+  im_ *= gain;
+  since_renorm_ = 0;
+}
+
+}  // namespace harq
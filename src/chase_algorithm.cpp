@@ -1,116 +1,103 @@
 #include "chase_algorithm.hpp"
 #include "hamming_decoder.hpp"
+#include "probe_patterns.hpp"
+#include "soft_metric.hpp"
 #include "utils.hpp"
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 namespace harq {
 std::vector<std::vector<uint8_t>> generate_probe_sequences_1(int n, int d) {
-  std::vector<std::vector<uint8_t>> result;
-  int ones_count = d / 2;
-
-  if (ones_count == 0) {
-    throw std::invalid_argument("Wrong input data: d should be >= 0");
-  }
+  // Сочетания строятся один раз на (n, d) и берутся из общего кэша.
+  const auto table = GetProbePatterns(n, d, ProbeAlgorithm::First);
 
-  if (ones_count > n) {
-    throw std::invalid_argument("Wrong input data: d/2 > n");
+  std::vector<std::vector<uint8_t>> result;
+  result.reserve(table->size());
+  for (int p = 0; p < table->size(); p++) {
+    std::vector<uint8_t> sequence(n, 0);
+    for (int position : table->Pattern(p)) {
+      sequence[position] = 1;
+    }
+    result.push_back(std::move(sequence));
   }
 
-  result.push_back(std::vector<uint8_t>(n, 0));
-  std::vector<uint8_t> mask(n, 0);
-  std::fill(mask.end() - ones_count, mask.end(), 1);
-
-  do {
-    result.push_back(mask);
-  } while (std::next_permutation(mask.begin(), mask.end()));
-
   return result;
 }
 
-std::vector<std::vector<uint8_t>>
-generate_probe_sequences_2(int n, int d,
-                           const std::vector<double> &reliability) {
-
-  std::vector<std::vector<uint8_t>> result;
+namespace {
 
-  if (n <= 0 || d <= 0 || reliability.size() != static_cast<size_t>(n)) {
-    throw std::invalid_argument("Reliability values are incorrect.");
+// Индексы count наименее надёжных позиций. До kMaxLeastReliable они
+// выбираются в буфер на стеке без выделения памяти, больше — через
+// get_n_smallest_indices в куче.
+class LeastReliableRanks {
+public:
+  LeastReliableRanks(const std::vector<double> &reliability, int count) {
+    if (count <= 0) {
+      return;
+    }
+    if (static_cast<size_t>(count) <= kMaxLeastReliable) {
+      ranks_ = std::span<size_t>(buffer_, count);
+      SelectLeastReliable(reliability, ranks_);
+    } else {
+      heap_ = get_n_smallest_indices(reliability, count);
+      ranks_ = heap_;
+    }
   }
 
-  int selection_positions = d / 2;
-  if (selection_positions > n) {
-    throw std::invalid_argument("Wrong input data: d/2 > n");
-  }
-  if (selection_positions == 0) {
-    result.push_back(std::vector<uint8_t>(n, 0));
-    return result;
-  }
+  LeastReliableRanks(const LeastReliableRanks &) = delete;
+  LeastReliableRanks &operator=(const LeastReliableRanks &) = delete;
 
-  auto min_indices = get_n_smallest_indices(reliability, selection_positions);
+  std::span<const size_t> ranks() const { return ranks_; }
 
-  int total_combinations = 1 << selection_positions;
+private:
+  size_t buffer_[kMaxLeastReliable];
+  std::vector<size_t> heap_;
+  std::span<size_t> ranks_;
+};
 
-  std::vector<uint8_t> base_sequence(n, 0);
+// Переводит ранги таблицы в позиции наименее надёжных битов слова.
+std::vector<std::vector<uint8_t>>
+expand_ranked_patterns(const ProbePatternTable &table,
+                       const std::vector<double> &reliability) {
+  const int n = table.n();
+  const LeastReliableRanks least_reliable(reliability, table.ranks());
+  const std::span<const size_t> ranks = least_reliable.ranks();
 
-  for (int mask = 0; mask < total_combinations; mask++) {
-    std::vector<uint8_t> sequence = base_sequence;
-    for (int i = 0; i < selection_positions; i++) {
-      char value = (mask >> i) & 1;
-      sequence[min_indices[i]] = value;
+  std::vector<std::vector<uint8_t>> result;
+  result.reserve(table.size());
+  for (int p = 0; p < table.size(); p++) {
+    std::vector<uint8_t> sequence(n, 0);
+    for (int rank : table.Pattern(p)) {
+      sequence[ranks[rank]] = 1;
     }
-
-    result.push_back(sequence);
+    result.push_back(std::move(sequence));
   }
-
   return result;
 }
 
+} // namespace
+
 std::vector<std::vector<uint8_t>>
-generate_probe_sequences_3(int n, int d,
+generate_probe_sequences_2(int n, int d,
                            const std::vector<double> &reliability) {
-  std::vector<std::vector<uint8_t>> result;
-
   if (n <= 0 || d <= 0 || reliability.size() != static_cast<size_t>(n)) {
     throw std::invalid_argument("Reliability values are incorrect.");
-    return result;
   }
 
-  int precarious_positions = d - 1;
-  if (precarious_positions > n) {
-    throw std::invalid_argument("Wrong input data: d-1 > n");
-  }
-
-  auto least_reliable_indices =
-      get_n_smallest_indices(reliability, precarious_positions);
-
-  std::vector<size_t> ones_positions;
-
-  if (d % 2 == 1) {
-    for (size_t i = 0; i < least_reliable_indices.size(); i += 2) {
-      ones_positions.push_back(least_reliable_indices[i]);
-    }
-  } else {
-    if (least_reliable_indices.size() >= 1) {
-      ones_positions.push_back(least_reliable_indices[0]);
-    }
-    if (least_reliable_indices.size() >= 2) {
-      ones_positions.push_back(least_reliable_indices[1]);
-    }
-    for (size_t i = 3; i < least_reliable_indices.size(); i += 2) {
-      ones_positions.push_back(least_reliable_indices[i]);
-    }
-  }
+  return expand_ranked_patterns(
+      *GetProbePatterns(n, d, ProbeAlgorithm::Second), reliability);
+}
 
-  std::vector<uint8_t> sequence(n, 0);
-  for (size_t pos : ones_positions) {
-    if (pos < static_cast<size_t>(n)) {
-      sequence[pos] = 1;
-    }
+std::vector<std::vector<uint8_t>>
+generate_probe_sequences_3(int n, int d,
+                           const std::vector<double> &reliability) {
+  if (n <= 0 || d <= 0 || reliability.size() != static_cast<size_t>(n)) {
+    throw std::invalid_argument("Reliability values are incorrect.");
   }
 
-  result.push_back(sequence);
-  return result;
+  return expand_ranked_patterns(
+      *GetProbePatterns(n, d, ProbeAlgorithm::Third), reliability);
 }
 
 std::vector<uint8_t> AddErrorVector(const std::vector<uint8_t> &DataVector,
@@ -122,40 +109,82 @@ std::vector<uint8_t> AddErrorVector(const std::vector<uint8_t> &DataVector,
   return NewVector;
 }
 
+BitVector AddErrorVector(const BitVector &DataVector,
+                         const BitVector &ErrorVector) {
+  return DataVector ^ ErrorVector;
+}
+
 std::vector<std::vector<uint8_t>>
 CalculateCandidates(const std::vector<uint8_t> &message, int r, int d,
                     const std::vector<double> &reliability,
                     ProbeAlgorithm algorithm) {
   HammingDecoder decoder(r);
-  auto DecodedWord = decoder.Decode(message);
 
+  // Тестовые последовательности накладываются на принятое жёсткое решение.
   std::vector<std::vector<uint8_t>> ProbeSeqs;
   switch (algorithm) {
   case ProbeAlgorithm::First:
-    ProbeSeqs = generate_probe_sequences_1(DecodedWord.size(), d);
+    ProbeSeqs = generate_probe_sequences_1(message.size(), d);
     break;
   case ProbeAlgorithm::Second:
-    ProbeSeqs = generate_probe_sequences_2(DecodedWord.size(), d, reliability);
+    ProbeSeqs = generate_probe_sequences_2(message.size(), d, reliability);
     break;
   case ProbeAlgorithm::Third:
-    ProbeSeqs = generate_probe_sequences_3(DecodedWord.size(), d, reliability);
+    ProbeSeqs = generate_probe_sequences_3(message.size(), d, reliability);
+    break;
+  case ProbeAlgorithm::ThirdNested:
+    if (reliability.size() != message.size()) {
+      throw std::invalid_argument("Reliability values are incorrect.");
+    }
+    ProbeSeqs = expand_ranked_patterns(
+        *GetProbePatterns(message.size(), d, ProbeAlgorithm::ThirdNested),
+        reliability);
     break;
   default:
     throw std::invalid_argument("Wrong probe algorithm chosen");
   }
 
-  std::vector<std::vector<uint8_t>> CandidatesVector(ProbeSeqs.size());
+  std::vector<std::vector<uint8_t>> CandidatesVector;
+  CandidatesVector.reserve(ProbeSeqs.size());
   for (const auto &ErrorVector : ProbeSeqs) {
-    auto NewVector = AddErrorVector(DecodedWord, ErrorVector);
-    auto DecodedNewVector = decoder.Decode(NewVector);
-    CandidatesVector.push_back(DecodedNewVector);
+    auto NewVector = AddErrorVector(message, ErrorVector);
+    CandidatesVector.push_back(decoder.Correct(NewVector));
+  }
+  return CandidatesVector;
+}
+
+std::vector<BitVector>
+CalculateCandidates(const BitVector &message, int r, int d,
+                    const std::vector<double> &reliability,
+                    ProbeAlgorithm algorithm) {
+  HammingDecoder decoder(r);
+  const int n = static_cast<int>(message.size());
+  if (algorithm != ProbeAlgorithm::First &&
+      (n <= 0 || d <= 0 || reliability.size() != static_cast<size_t>(n))) {
+    throw std::invalid_argument("Reliability values are incorrect.");
+  }
+
+  // Шаблоны берутся из кэша и накладываются на слово инверсией битов, без
+  // промежуточных последовательностей по байту на бит.
+  const auto table = GetProbePatterns(n, d, algorithm);
+  const LeastReliableRanks least_reliable(reliability, table->ranks());
+  const std::span<const size_t> ranks = least_reliable.ranks();
+
+  std::vector<BitVector> CandidatesVector;
+  CandidatesVector.reserve(table->size());
+  for (int p = 0; p < table->size(); p++) {
+    BitVector candidate = message;
+    for (int value : table->Pattern(p)) {
+      candidate.Flip(ranks.empty() ? value : ranks[value]);
+    }
+    CandidatesVector.push_back(decoder.Correct(candidate));
   }
   return CandidatesVector;
 }
 
 std::pair<double, std::vector<uint8_t>>
-CalculateDistance(std::vector<uint8_t> candidate,
-                  std::vector<double> SoftDecisions) {
+CalculateDistance(const std::vector<uint8_t> &candidate,
+                  const std::vector<double> &SoftDecisions) {
   double result = 0;
   for (auto i = 0; i < candidate.size(); ++i) {
     result += std::abs(static_cast<double>(candidate[i]) - SoftDecisions[i]);
@@ -163,15 +192,56 @@ CalculateDistance(std::vector<uint8_t> candidate,
   return {result, candidate};
 }
 
-std::vector<uint8_t> MakeDecision(std::vector<std::vector<uint8_t>> candidates,
-                                  std::vector<double> SoftDecisions) {
-  std::vector<std::pair<double, std::vector<uint8_t>>> distances;
-  for (const auto &candidate : candidates) {
-    auto CandidateWithDistance = CalculateDistance(candidate, SoftDecisions);
-    distances.push_back(CandidateWithDistance);
+namespace {
+
+// Кандидаты укладываются в строки подряд один раз и оцениваются векторным
+// ядром; побеждает первый кандидат с наименьшей метрикой.
+template <typename T, typename Acc>
+size_t BestCandidate(const std::vector<std::vector<uint8_t>> &candidates,
+                     std::span<const T> llr) {
+  if (candidates.empty()) {
+    throw std::invalid_argument("Candidates list is empty.");
   }
-  std::sort(distances.begin(), distances.end(),
-            [](const auto &a, const auto &b) { return a.first < b.first; });
-  return distances[0].second;
+  const size_t n = llr.size();
+  std::vector<uint8_t> rows(candidates.size() * n);
+  for (size_t row = 0; row < candidates.size(); ++row) {
+    if (candidates[row].size() != n) {
+      throw std::invalid_argument(
+          "Candidate and soft decision sizes must match.");
+    }
+    std::copy(candidates[row].begin(), candidates[row].end(),
+              rows.begin() + row * n);
+  }
+  std::vector<Acc> metrics(candidates.size());
+  ScoreCandidates(llr, rows, std::span<Acc>(metrics), DetectSimdLevel());
+  return std::min_element(metrics.begin(), metrics.end()) - metrics.begin();
+}
+
+} // namespace
+
+std::vector<uint8_t>
+MakeDecision(const std::vector<std::vector<uint8_t>> &candidates,
+             const std::vector<double> &SoftDecisions) {
+  // sum |c_i - s_i| отличается от корреляционной метрики ScoreCandidates
+  // с LLR clamp(2 s_i - 1, -1, 1) на слагаемое, не зависящее от кандидата,
+  // поэтому минимум у них общий.
+  std::vector<double> llr(SoftDecisions.size());
+  for (size_t i = 0; i < llr.size(); ++i) {
+    llr[i] = std::clamp(2.0 * SoftDecisions[i] - 1.0, -1.0, 1.0);
+  }
+  return candidates[BestCandidate<double, double>(
+      candidates, std::span<const double>(llr))];
+}
+
+std::vector<uint8_t>
+MakeDecision(const std::vector<std::vector<uint8_t>> &candidates,
+             std::span<const int8_t> llr) {
+  return candidates[BestCandidate<int8_t, int32_t>(candidates, llr)];
+}
+
+std::vector<uint8_t>
+MakeDecision(const std::vector<std::vector<uint8_t>> &candidates,
+             std::span<const int16_t> llr) {
+  return candidates[BestCandidate<int16_t, int32_t>(candidates, llr)];
 }
 } // namespace harq
@@ -0,0 +1,373 @@
+#include "chase_decoder.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "bit_packing.hpp"
+#include "instrumentation.hpp"
+#include "noise_generator.hpp"
+#include "probe_patterns.hpp"
+#include "utils.hpp"
+
+namespace harq {
+
+namespace {
+
+#if HARQ_INSTRUMENTATION_ENABLED
+// Счётчики кандидатов кадра, заполняемые в цикле оценки. Исправленный
+// кандидат отличается от жёсткого решения тестовой последовательностью и
+// позицией исправления; его отпечаток — XOR ключей этих позиций (хеш
+// Зобриста), который ведётся вместе с синдромом. Различные отпечатки
+// копятся в открытой хеш-таблице фиксированного размера на стеке; сверх
+// kMaxDistinct отпечатков новые считаются различными без проверки
+// (оценка сверху).
+class CandidateTally {
+ public:
+  static constexpr int kMaxDistinct = 512;
+
+  explicit CandidateTally(int patterns)
+      : mask_(std::bit_ceil(
+                  static_cast<unsigned>(2 * std::min(patterns, kMaxDistinct))) -
+              1) {
+    std::fill_n(slots_, mask_ + 1, uint64_t{0});
+  }
+
+  void Flip(int position) { print_ ^= Key(position); }
+
+  void Add(int syndrome) {
+    uint64_t print = print_;
+    if (syndrome == 0) {
+      syndrome_zero_++;
+    } else {
+      print ^= Key(syndrome - 1);
+    }
+    candidates_++;
+    Insert(print);
+  }
+
+  // Новая тестовая последовательность строится с нуля.
+  void StartPattern() { print_ = 0; }
+
+  void Report() const {
+    HARQ_COUNT(kCandidates, candidates_);
+    HARQ_COUNT(kDistinctCandidates, distinct_);
+    HARQ_COUNT(kSyndromeZero, syndrome_zero_);
+  }
+
+ private:
+  static uint64_t Key(int position) {
+    return Mix64(static_cast<uint64_t>(position + 1) * 0x9E3779B97F4A7C15ull);
+  }
+
+  void Insert(uint64_t print) {
+    // Нулевой отпечаток (кандидат равен жёсткому решению) хранится
+    // флагом: 0 в таблице означает пустую ячейку.
+    if (print == 0) {
+      distinct_ += !has_zero_;
+      has_zero_ = true;
+      return;
+    }
+    if (stored_ == kMaxDistinct) {
+      distinct_++;
+      return;
+    }
+    for (uint64_t i = print & mask_;; i = (i + 1) & mask_) {
+      if (slots_[i] == print) {
+        return;
+      }
+      if (slots_[i] == 0) {
+        slots_[i] = print;
+        stored_++;
+        distinct_++;
+        return;
+      }
+    }
+  }
+
+  uint64_t mask_;
+  uint64_t print_ = 0;
+  uint64_t candidates_ = 0;
+  uint64_t distinct_ = 0;
+  uint64_t syndrome_zero_ = 0;
+  int stored_ = 0;
+  bool has_zero_ = false;
+  uint64_t slots_[2 * kMaxDistinct];
+};
+#else
+// Без инструментирования вызовы пустые и исчезают при компиляции.
+struct CandidateTally {
+  explicit CandidateTally(int) {}
+  void Flip(int) {}
+  void Add(int) {}
+  void StartPattern() {}
+  void Report() const {}
+};
+#endif
+
+}  // namespace
+
+ChaseDecoder::ChaseDecoder(int r, int d, ProbeAlgorithm algorithm)
+    : decoder_(r), d_(d), algorithm_(algorithm), patterns_(0), flips_(0),
+      selection_(0), words_(decoder_.codeword_words()) {
+  if (d_ <= 0) {
+    throw std::invalid_argument("Chase decoder expects d > 0.");
+  }
+
+  BuildPatterns();
+
+  least_reliable_.assign(selection_, 0);
+  in_pattern_.assign(decoder_.n(), 0);
+  hard_.assign(words_, 0);
+  candidate_.assign(words_, 0);
+  data_.assign(decoder_.data_words(), 0);
+}
+
+int ChaseDecoder::n() const { return decoder_.n(); }
+
+int ChaseDecoder::k() const { return decoder_.k(); }
+
+int ChaseDecoder::patterns() const { return patterns_; }
+
+void ChaseDecoder::Decode(std::span<const double> llr,
+                          std::span<uint8_t> out) {
+  DecodeLlr(llr, out);
+}
+
+void ChaseDecoder::Decode(std::span<const int8_t> llr,
+                          std::span<uint8_t> out) {
+  DecodeLlr(llr, out);
+}
+
+void ChaseDecoder::Decode(std::span<const int16_t> llr,
+                          std::span<uint8_t> out) {
+  DecodeLlr(llr, out);
+}
+
+template <typename T>
+void ChaseDecoder::DecodeLlr(std::span<const T> llr,
+                             std::span<uint8_t> out) {
+  // Для целых LLR метрика точна в int32_t.
+  using Metric =
+      std::conditional_t<std::is_floating_point_v<T>, double, int32_t>;
+
+  const int n = decoder_.n();
+  if (static_cast<int>(llr.size()) != n &&
+      static_cast<int>(llr.size()) != n + 1) {
+    throw std::invalid_argument("Chase decoder expects n or n+1 LLR values.");
+  }
+  if (static_cast<int>(out.size()) != decoder_.k()) {
+    throw std::invalid_argument("Chase decoder expects k output bits.");
+  }
+  const bool extended = static_cast<int>(llr.size()) == n + 1;
+  HARQ_STAGE(kChaseDecode);
+
+  std::fill(hard_.begin(), hard_.end(), 0);
+  int hard_parity = 0;
+  for (int i = 0; i < n; i++) {
+    const uint64_t bit = llr[i] >= 0;
+    hard_[i / 64] |= bit << (i % 64);
+    hard_parity ^= static_cast<int>(bit);
+  }
+  const int parity_bit = extended && llr[n] >= 0 ? 1 : 0;
+  if (selection_ > 0) {
+    SelectLeastReliable(llr.first(n), least_reliable_);
+  }
+
+  // Кандидаты не строятся: синдром и метрика тестовой последовательности
+  // обновляются при каждой инверсии, а исправление Хэмминга добавляет к
+  // метрике одну позицию. Хранится только лучшая последовательность.
+  const int hard_syndrome = decoder_.SyndromePacked(hard_);
+  CandidateTally tally(patterns_);
+  auto score = [&](int syndrome, Metric metric, int weight) {
+    tally.Add(syndrome);
+    if (syndrome != 0) {
+      const int position = syndrome - 1;
+      const Metric reliability = std::abs(llr[position]);
+      metric += in_pattern_[position] ? -reliability : reliability;
+      weight ^= 1;
+    }
+    if (extended && (hard_parity ^ weight) != parity_bit) {
+      metric += std::abs(llr[n]);
+    }
+    return metric;
+  };
+
+  Metric best_metric = std::numeric_limits<Metric>::max();
+  int best_pattern = 0;
+  auto consider = [&](int pattern, Metric metric) {
+    if (metric < best_metric) {
+      best_metric = metric;
+      best_pattern = pattern;
+    }
+  };
+
+  int syndrome = hard_syndrome;
+  Metric metric = 0;
+  int weight = 0;
+  switch (algorithm_) {
+    case ProbeAlgorithm::First:
+    case ProbeAlgorithm::Third:
+      // Последовательности таблицы независимы; у Third элементы — ранги.
+      for (int p = 0; p < patterns_; p++) {
+        int probe[64];
+        const int count = ProbePositions(p, probe);
+        syndrome = hard_syndrome;
+        metric = 0;
+        tally.StartPattern();
+        for (int i = 0; i < count; i++) {
+          tally.Flip(probe[i]);
+          syndrome ^= probe[i] + 1;
+          metric += std::abs(llr[probe[i]]);
+          in_pattern_[probe[i]] = 1;
+        }
+        consider(p, score(syndrome, metric, count & 1));
+        for (int i = 0; i < count; i++) {
+          in_pattern_[probe[i]] = 0;
+        }
+      }
+      break;
+    case ProbeAlgorithm::Second:
+      // Код Грея: соседние последовательности отличаются одной позицией.
+      consider(0, score(syndrome, metric, weight));
+      for (int i = 1; i < patterns_; i++) {
+        const int position = static_cast<int>(
+            least_reliable_[std::countr_zero(static_cast<unsigned>(i))]);
+        const Metric reliability = std::abs(llr[position]);
+        metric += in_pattern_[position] ? -reliability : reliability;
+        in_pattern_[position] ^= 1;
+        tally.Flip(position);
+        syndrome ^= position + 1;
+        weight ^= 1;
+        consider(i ^ (i >> 1), score(syndrome, metric, weight));
+      }
+      for (int i = 0; i < flips_; i++) {
+        in_pattern_[least_reliable_[i]] = 0;
+      }
+      break;
+    case ProbeAlgorithm::ThirdNested: {
+      // Каждая следующая последовательность расширяет предыдущую.
+      int flipped = 0;
+      for (int p = 0; p < patterns_; p++) {
+        for (; flipped < probe_table_[p]; flipped++) {
+          const int position = static_cast<int>(least_reliable_[flipped]);
+          metric += std::abs(llr[position]);
+          in_pattern_[position] = 1;
+          tally.Flip(position);
+          syndrome ^= position + 1;
+          weight ^= 1;
+        }
+        consider(p, score(syndrome, metric, weight));
+      }
+      for (int i = 0; i < flipped; i++) {
+        in_pattern_[least_reliable_[i]] = 0;
+      }
+      break;
+    }
+  }
+
+  tally.Report();
+
+  // Лучший кандидат — жёсткое решение с тестовой последовательностью,
+  // исправленное декодером Хэмминга.
+  std::copy(hard_.begin(), hard_.end(), candidate_.begin());
+  int probe[64];
+  const int count = ProbePositions(best_pattern, probe);
+  for (int i = 0; i < count; i++) {
+    FlipBit(candidate_, probe[i]);
+  }
+  decoder_.DecodePacked(candidate_, false, data_);
+  UnpackBits(data_, out);
+}
+
+void ChaseDecoder::BuildPatterns() {
+  const int n = decoder_.n();
+
+  switch (algorithm_) {
+    case ProbeAlgorithm::First:
+      // Все сочетания по d/2 позиций берутся из общего кэша таблиц.
+      table_ = GetProbePatterns(n, d_, ProbeAlgorithm::First);
+      flips_ = d_ / 2;
+      patterns_ = table_->size();
+      break;
+    case ProbeAlgorithm::Second:
+      flips_ = d_ / 2;
+      if (flips_ > n) {
+        throw std::invalid_argument("Wrong input data: d/2 > n");
+      }
+      if (flips_ >= 31) {
+        throw std::invalid_argument("Too many Chase test patterns.");
+      }
+      selection_ = flips_;
+      patterns_ = 1 << flips_;
+      break;
+    case ProbeAlgorithm::Third:
+      // Одна последовательность рангов из кэша, без нулевой.
+      table_ = GetProbePatterns(n, d_, ProbeAlgorithm::Third);
+      selection_ = table_->ranks();
+      flips_ = static_cast<int>(table_->Pattern(0).size());
+      patterns_ = table_->size();
+      break;
+    case ProbeAlgorithm::ThirdNested:
+      selection_ = d_ - 1;
+      if (selection_ == 0) {
+        throw std::invalid_argument("Reliability values are incorrect.");
+      }
+      if (selection_ > n) {
+        throw std::invalid_argument("Wrong input data: d-1 > n");
+      }
+      // Алгоритм 3 Чейза: единицы в m наименее надёжных позициях, где
+      // m = 0, 2, 4, ..., d-1 (нечётное d) или m = 0, 1, 3, ..., d-1.
+      probe_table_.push_back(0);
+      for (int m = d_ % 2 == 1 ? 2 : 1; m <= selection_; m += 2) {
+        probe_table_.push_back(m);
+      }
+      patterns_ = static_cast<int>(probe_table_.size());
+      flips_ = selection_;
+      break;
+    default:
+      throw std::invalid_argument("Wrong probe algorithm chosen");
+  }
+
+  if (flips_ > 64 ||
+      static_cast<std::size_t>(selection_) > kMaxLeastReliable) {
+    throw std::invalid_argument("Too many Chase test positions.");
+  }
+}
+
+int ChaseDecoder::ProbePositions(int pattern, int* probe) const {
+  switch (algorithm_) {
+    case ProbeAlgorithm::First: {
+      const std::span<const int> positions = table_->Pattern(pattern);
+      std::copy(positions.begin(), positions.end(), probe);
+      return static_cast<int>(positions.size());
+    }
+    case ProbeAlgorithm::Third: {
+      const std::span<const int> ranks = table_->Pattern(pattern);
+      for (std::size_t i = 0; i < ranks.size(); i++) {
+        probe[i] = static_cast<int>(least_reliable_[ranks[i]]);
+      }
+      return static_cast<int>(ranks.size());
+    }
+    case ProbeAlgorithm::Second: {
+      int count = 0;
+      for (int i = 0; i < flips_; i++) {
+        if ((pattern >> i) & 1) {
+          probe[count++] = static_cast<int>(least_reliable_[i]);
+        }
+      }
+      return count;
+    }
+    case ProbeAlgorithm::ThirdNested:
+      for (int i = 0; i < probe_table_[pattern]; i++) {
+        probe[i] = static_cast<int>(least_reliable_[i]);
+      }
+      return probe_table_[pattern];
+  }
+  return 0;
+}
+
+}  // namespace harq
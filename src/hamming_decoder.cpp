@@ -1,10 +1,84 @@
 #include "hamming_decoder.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <stdexcept>
 
+#include "bit_packing.hpp"
+#include "hamming_codec.hpp"
+#include "instrumentation.hpp"
+
 namespace harq {
 
-HammingDecoder::HammingDecoder(int r) : r_(r), n_(0), k_(0) {
+namespace {
+
+// Группа из L срезов по 64 слова; циклы фиксированной длины компилятор
+// сворачивает в SSE2/AVX2-операции.
+template <int L>
+struct SliceLanes {
+  uint64_t w[L];
+
+  static SliceLanes Zero() {
+    SliceLanes lanes;
+    for (int l = 0; l < L; l++) {
+      lanes.w[l] = 0;
+    }
+    return lanes;
+  }
+
+  static SliceLanes Load(const uint64_t* src) {
+    SliceLanes lanes;
+    for (int l = 0; l < L; l++) {
+      lanes.w[l] = src[l];
+    }
+    return lanes;
+  }
+
+  void Store(uint64_t* dst) const {
+    for (int l = 0; l < L; l++) {
+      dst[l] = w[l];
+    }
+  }
+
+  SliceLanes operator^(const SliceLanes& other) const {
+    SliceLanes lanes;
+    for (int l = 0; l < L; l++) {
+      lanes.w[l] = w[l] ^ other.w[l];
+    }
+    return lanes;
+  }
+
+  SliceLanes operator&(const SliceLanes& other) const {
+    SliceLanes lanes;
+    for (int l = 0; l < L; l++) {
+      lanes.w[l] = w[l] & other.w[l];
+    }
+    return lanes;
+  }
+
+  SliceLanes operator|(const SliceLanes& other) const {
+    SliceLanes lanes;
+    for (int l = 0; l < L; l++) {
+      lanes.w[l] = w[l] | other.w[l];
+    }
+    return lanes;
+  }
+
+  SliceLanes operator~() const {
+    SliceLanes lanes;
+    for (int l = 0; l < L; l++) {
+      lanes.w[l] = ~w[l];
+    }
+    return lanes;
+  }
+
+  int Bit(int word) const { return (w[word / 64] >> (word % 64)) & 1; }
+};
+
+}  // namespace
+
+HammingDecoder::HammingDecoder(int r)
+    : r_(r), n_(0), k_(0), data_words_(0), codeword_words_(0) {
   if (r_ < 2) {
     throw std::invalid_argument("Hamming decoder expects r >= 2.");
   }
@@ -17,59 +91,84 @@ HammingDecoder::HammingDecoder(int r) : r_(r), n_(0), k_(0) {
       data_positions_.push_back(pos);
     }
   }
+
+  BuildPackedTables();
 }
 
 int HammingDecoder::n() const { return n_; }
 
 int HammingDecoder::k() const { return k_; }
 
+int HammingDecoder::data_words() const { return data_words_; }
+
+int HammingDecoder::codeword_words() const { return codeword_words_; }
+
 std::vector<uint8_t> HammingDecoder::Correct(
     const std::vector<uint8_t>& codeword) const {
-  if (static_cast<int>(codeword.size()) != n_ &&
-      static_cast<int>(codeword.size()) != n_ + 1) {
-    throw std::invalid_argument(
-        "Hamming decoder expects n or n+1 codeword bits.");
-  }
+  ValidateCodeword(codeword);
 
-  for (uint8_t bit : codeword) {
-    if (bit != 0 && bit != 1) {
-      throw std::invalid_argument("Hamming decoder expects bits 0 or 1.");
-    }
+  const bool extended = static_cast<int>(codeword.size()) == n_ + 1;
+  std::vector<uint8_t> corrected(codeword.size(), 0);
+
+  if (r_ <= kMaxSingleWordR) {
+    uint64_t packed = 0;
+    PackBits(codeword, std::span<uint64_t>(&packed, 1));
+    CorrectPacked(packed, extended);
+    UnpackBits(std::span<const uint64_t>(&packed, 1), corrected);
+    return corrected;
   }
 
-  std::vector<uint8_t> corrected = codeword;
+  std::vector<uint64_t> packed(codeword_words_, 0);
+  PackBits(std::span<const uint8_t>(codeword), packed);
+  int flip_position = -1;
+  const int parity =
+      extended ? std::count(codeword.begin(), codeword.end(), 1) & 1 : 0;
+  const DecodeStatus status =
+      Classify(SyndromePacked(packed), parity, extended, flip_position);
+  HARQ_COUNT_STATUS(status);
+  if (flip_position >= 0) {
+    FlipBit(packed, flip_position);
+  }
+  UnpackBits(packed, corrected);
+  return corrected;
+}
 
-  bool extended = static_cast<int>(codeword.size()) == n_ + 1;
-  int syndrome = ComputeSyndrome(corrected);
+std::vector<uint8_t> HammingDecoder::Decode(
+    const std::vector<uint8_t>& codeword) const {
+  return DecodeWithStatus(codeword).first;
+}
 
-  if (extended) {
-    uint8_t overall_parity = 0;
-    for (uint8_t bit : corrected) {
-      overall_parity ^= bit;
-    }
+BitVector HammingDecoder::Correct(const BitVector& codeword) const {
+  ValidateCodeword(codeword);
 
-    if (syndrome == 0 && overall_parity == 1) {
-      corrected.back() ^= 1;
-    } else if (syndrome != 0 && overall_parity == 1) {
-      corrected[syndrome - 1] ^= 1;
-    }
-  } else if (syndrome > 0 && syndrome <= n_) {
-    corrected[syndrome - 1] ^= 1;
+  const bool extended = static_cast<int>(codeword.size()) == n_ + 1;
+  BitVector corrected = codeword;
+  if (r_ <= kMaxSingleWordR) {
+    CorrectPacked(corrected.words()[0], extended);
+    return corrected;
   }
 
+  int flip_position = -1;
+  const int parity = extended ? static_cast<int>(codeword.Popcount() & 1) : 0;
+  const DecodeStatus status = Classify(SyndromePacked(codeword.words()),
+                                      parity, extended, flip_position);
+  HARQ_COUNT_STATUS(status);
+  if (flip_position >= 0) {
+    corrected.Flip(flip_position);
+  }
   return corrected;
 }
 
-std::vector<uint8_t> HammingDecoder::Decode(
-    const std::vector<uint8_t>& codeword) const {
-  std::vector<uint8_t> corrected = Correct(codeword);
+BitVector HammingDecoder::Decode(const BitVector& codeword) const {
+  ValidateCodeword(codeword);
 
-  std::vector<uint8_t> data;
-  data.reserve(k_);
-  for (int pos : data_positions_) {
-    data.push_back(corrected[pos - 1]);
+  const bool extended = static_cast<int>(codeword.size()) == n_ + 1;
+  BitVector data(k_);
+  if (r_ <= kMaxSingleWordR) {
+    DecodePacked(codeword.words()[0], extended, data.words()[0]);
+  } else {
+    DecodePacked(codeword.words(), extended, data.words());
   }
-
   return data;
 }
 
@@ -77,21 +176,217 @@ bool HammingDecoder::IsPowerOfTwo(int value) {
   return value > 0 && (value & (value - 1)) == 0;
 }
 
-int HammingDecoder::ComputeSyndrome(
-    const std::vector<uint8_t>& codeword) const {
+std::pair<std::vector<uint8_t>, HammingDecoder::DecodeStatus>
+HammingDecoder::DecodeWithStatus(const std::vector<uint8_t>& codeword) const {
+  ValidateCodeword(codeword);
+
+  const bool extended = static_cast<int>(codeword.size()) == n_ + 1;
+  std::vector<uint8_t> data(k_, 0);
+  DecodeStatus status = DecodeStatus::kNoError;
+
+  if (r_ <= kMaxSingleWordR) {
+    uint64_t packed = 0;
+    uint64_t packed_data = 0;
+    PackBits(codeword, std::span<uint64_t>(&packed, 1));
+    status = DecodePacked(packed, extended, packed_data);
+    UnpackBits(std::span<const uint64_t>(&packed_data, 1), data);
+  } else {
+    std::vector<uint64_t> packed_data(data_words_, 0);
+    status = DecodePacked(PackBits(codeword), extended, packed_data);
+    UnpackBits(packed_data, data);
+  }
+
+  return {data, status};
+}
+
+int HammingDecoder::SyndromePacked(uint64_t codeword) const {
+  CheckSingleWord();
+  return VisitHammingCodec(r_, [codeword](auto codec) {
+    return decltype(codec)::Syndrome(codeword);
+  });
+}
+
+HammingDecoder::DecodeStatus HammingDecoder::CorrectPacked(
+    uint64_t& codeword, bool extended) const {
+  CheckSingleWord();
+  const DecodeStatus status =
+      VisitHammingCodec(r_, [&codeword, extended](auto codec) {
+        return decltype(codec)::Correct(codeword, extended);
+      });
+  HARQ_COUNT_STATUS(status);
+  return status;
+}
+
+uint64_t HammingDecoder::ExtractDataPacked(uint64_t codeword) const {
+  CheckSingleWord();
+  return VisitHammingCodec(r_, [codeword](auto codec) {
+    return decltype(codec)::ExtractData(codeword);
+  });
+}
+
+HammingDecoder::DecodeStatus HammingDecoder::DecodePacked(
+    uint64_t codeword, bool extended, uint64_t& data) const {
+  CheckSingleWord();
+  const DecodeStatus status =
+      VisitHammingCodec(r_, [codeword, extended, &data](auto codec) {
+        return decltype(codec)::Decode(codeword, extended, data);
+      });
+  HARQ_COUNT_STATUS(status);
+  return status;
+}
+
+int HammingDecoder::SyndromePacked(std::span<const uint64_t> codeword) const {
+  if (static_cast<int>(codeword.size()) < codeword_words_) {
+    throw std::invalid_argument("Packed Hamming buffers are too small.");
+  }
+  if (r_ <= kMaxSingleWordR) {
+    return SyndromePacked(codeword[0]);
+  }
+
+  // Бит общего паритета (позиция n+1) не входит ни в одну строку H.
   int syndrome = 0;
-  // Синдром соответствует XOR индексов позиций с единичными битами.
-  int limit = std::min(static_cast<int>(codeword.size()), n_);
-  for (int pos = 1; pos <= limit; pos++) {
-    if (codeword[pos - 1] == 1) {
-      syndrome ^= pos;
+  for (int j = 0; j < r_; j++) {
+    const uint64_t* row = &h_rows_[j * codeword_words_];
+    int ones = 0;
+    for (int w = 0; w < codeword_words_; w++) {
+      ones += std::popcount(codeword[w] & row[w]);
     }
+    syndrome |= (ones & 1) << j;
   }
   return syndrome;
 }
 
-std::pair<std::vector<uint8_t>, HammingDecoder::DecodeStatus>
-HammingDecoder::DecodeWithStatus(const std::vector<uint8_t>& codeword) const {
+HammingDecoder::DecodeStatus HammingDecoder::DecodePacked(
+    std::span<const uint64_t> codeword, bool extended,
+    std::span<uint64_t> data) const {
+  if (static_cast<int>(data.size()) < data_words_ ||
+      static_cast<int>(codeword.size()) < codeword_words_) {
+    throw std::invalid_argument("Packed Hamming buffers are too small.");
+  }
+  if (r_ <= kMaxSingleWordR) {
+    return DecodePacked(codeword[0], extended, data[0]);
+  }
+
+  const int syndrome = SyndromePacked(codeword);
+  int parity = 0;
+  if (extended) {
+    for (int w = 0; w < codeword_words_; w++) {
+      const uint64_t valid =
+          LowBitsMask(std::min(64, n_ + 1 - 64 * w));
+      parity ^= Parity64(codeword[w] & valid);
+    }
+  }
+
+  int flip_position = -1;
+  const DecodeStatus status =
+      Classify(syndrome, parity, extended, flip_position);
+  HARQ_COUNT_STATUS(status);
+
+  std::fill(data.begin(), data.begin() + data_words_, 0);
+  std::size_t offset = 0;
+  for (int j = 1; j < r_; j++) {
+    const std::size_t run = (std::size_t{1} << j) - 1;
+    CopyBits(codeword, std::size_t{1} << j, data, offset, run);
+    offset += run;
+  }
+
+  // Исправляем сразу в данных: ошибки в паритетах на данные не влияют.
+  const int pos = flip_position + 1;
+  if (flip_position >= 0 && pos <= n_ && !IsPowerOfTwo(pos)) {
+    FlipBit(data, pos - std::bit_width(static_cast<unsigned>(pos)) - 1);
+  }
+  return status;
+}
+
+void HammingDecoder::DecodeBatch(std::span<const uint64_t> codeword_slices,
+                                 bool extended,
+                                 std::span<uint64_t> data_slices,
+                                 std::span<DecodeStatus> statuses) const {
+  DecodeSliced<1>(codeword_slices, extended, data_slices, statuses);
+}
+
+void HammingDecoder::DecodeBatch256(std::span<const uint64_t> codeword_slices,
+                                    bool extended,
+                                    std::span<uint64_t> data_slices,
+                                    std::span<DecodeStatus> statuses) const {
+  DecodeSliced<4>(codeword_slices, extended, data_slices, statuses);
+}
+
+template <int Lanes>
+void HammingDecoder::DecodeSliced(std::span<const uint64_t> codeword_slices,
+                                  bool extended,
+                                  std::span<uint64_t> data_slices,
+                                  std::span<DecodeStatus> statuses) const {
+  using Slice = SliceLanes<Lanes>;
+  constexpr int kWords = 64 * Lanes;
+
+  if (r_ > kMaxBatchR) {
+    throw std::invalid_argument("Batch Hamming decoding expects r <= 10.");
+  }
+  const int slices = extended ? n_ + 1 : n_;
+  if (static_cast<int>(codeword_slices.size()) < slices * Lanes ||
+      static_cast<int>(data_slices.size()) < k_ * Lanes ||
+      static_cast<int>(statuses.size()) < kWords) {
+    throw std::invalid_argument("Batch Hamming buffers are too small.");
+  }
+
+  const uint64_t* in = codeword_slices.data();
+  Slice syndrome[kMaxBatchR];
+  for (int j = 0; j < r_; j++) {
+    syndrome[j] = Slice::Zero();
+  }
+  Slice parity = Slice::Zero();
+  for (int pos = 1; pos <= n_; pos++) {
+    const Slice bit = Slice::Load(in + (pos - 1) * Lanes);
+    parity = parity ^ bit;
+    for (int j = 0; j < r_; j++) {
+      if ((pos >> j) & 1) {
+        syndrome[j] = syndrome[j] ^ bit;
+      }
+    }
+  }
+  if (extended) {
+    parity = parity ^ Slice::Load(in + n_ * Lanes);
+  }
+
+  Slice nonzero = Slice::Zero();
+  for (int j = 0; j < r_; j++) {
+    nonzero = nonzero | syndrome[j];
+  }
+  // Без расширения исправляем любой ненулевой синдром, с расширением —
+  // только при нечётном общем паритете.
+  const Slice enable = extended ? (nonzero & parity) : nonzero;
+
+  // Индикаторы совпадения синдрома с каждой позицией строятся деревом
+  // минтермов: 2^(r+1) операций вместо k*r.
+  Slice minterms[1 << kMaxBatchR];
+  minterms[0] = enable;
+  for (int j = r_ - 1, count = 1; j >= 0; j--, count *= 2) {
+    for (int i = count - 1; i >= 0; i--) {
+      const Slice base = minterms[i];
+      minterms[2 * i + 1] = base & syndrome[j];
+      minterms[2 * i] = base & ~syndrome[j];
+    }
+  }
+
+  uint64_t* out = data_slices.data();
+  for (int i = 0; i < k_; i++) {
+    const int pos = data_positions_[i];
+    const Slice corrected =
+        Slice::Load(in + (pos - 1) * Lanes) ^ minterms[pos];
+    corrected.Store(out + i * Lanes);
+  }
+
+  for (int word = 0; word < kWords; word++) {
+    int flip_position = -1;
+    statuses[word] = Classify(nonzero.Bit(word), extended ? parity.Bit(word) : 0,
+                              extended, flip_position);
+    HARQ_COUNT_STATUS(statuses[word]);
+  }
+}
+
+void HammingDecoder::ValidateCodeword(
+    const std::vector<uint8_t>& codeword) const {
   if (static_cast<int>(codeword.size()) != n_ &&
       static_cast<int>(codeword.size()) != n_ + 1) {
     throw std::invalid_argument(
@@ -103,46 +398,63 @@ HammingDecoder::DecodeWithStatus(const std::vector<uint8_t>& codeword) const {
       throw std::invalid_argument("Hamming decoder expects bits 0 or 1.");
     }
   }
+}
 
-  bool extended = static_cast<int>(codeword.size()) == n_ + 1;
-  std::vector<uint8_t> corrected = codeword;
-  int syndrome = ComputeSyndrome(corrected);
+void HammingDecoder::ValidateCodeword(const BitVector& codeword) const {
+  if (static_cast<int>(codeword.size()) != n_ &&
+      static_cast<int>(codeword.size()) != n_ + 1) {
+    throw std::invalid_argument(
+        "Hamming decoder expects n or n+1 codeword bits.");
+  }
+}
 
-  DecodeStatus status = DecodeStatus::kNoError;
+void HammingDecoder::BuildPackedTables() {
+  data_words_ = static_cast<int>(PackedWordCount(k_));
+  codeword_words_ = static_cast<int>(PackedWordCount(n_ + 1));
 
-  if (extended) {
-    uint8_t overall_parity = 0;
-    for (uint8_t bit : corrected) {
-      overall_parity ^= bit;
+  h_rows_.assign(static_cast<std::size_t>(r_) * codeword_words_, 0);
+  for (int j = 0; j < r_; j++) {
+    std::span<uint64_t> row(&h_rows_[j * codeword_words_], codeword_words_);
+    for (int pos = 1; pos <= n_; pos++) {
+      if ((pos & (1 << j)) != 0) {
+        FlipBit(row, pos - 1);
+      }
     }
+  }
+}
 
-    if (syndrome == 0 && overall_parity == 0) {
-      status = DecodeStatus::kNoError;
-    } else if (syndrome != 0 && overall_parity == 1) {
-      corrected[syndrome - 1] ^= 1;
-      status = DecodeStatus::kCorrected;
-    } else if (syndrome == 0 && overall_parity == 1) {
-      corrected.back() ^= 1;
-      status = DecodeStatus::kParityCorrected;
-    } else {
-      status = DecodeStatus::kDetectedDouble;
-    }
-  } else {
+void HammingDecoder::CheckSingleWord() const {
+  if (r_ > kMaxSingleWordR) {
+    throw std::invalid_argument(
+        "Single-word packed decoding expects r <= 6.");
+  }
+}
+
+HammingDecoder::DecodeStatus HammingDecoder::Classify(
+    int syndrome, int overall_parity, bool extended,
+    int& flip_position) const {
+  flip_position = -1;
+
+  if (!extended) {
     if (syndrome > 0 && syndrome <= n_) {
-      corrected[syndrome - 1] ^= 1;
-      status = DecodeStatus::kCorrected;
-    } else {
-      status = DecodeStatus::kNoError;
+      flip_position = syndrome - 1;
+      return DecodeStatus::kCorrected;
     }
+    return DecodeStatus::kNoError;
   }
 
-  std::vector<uint8_t> data;
-  data.reserve(k_);
-  for (int pos : data_positions_) {
-    data.push_back(corrected[pos - 1]);
+  if (syndrome == 0 && overall_parity == 0) {
+    return DecodeStatus::kNoError;
   }
-
-  return {data, status};
+  if (syndrome != 0 && overall_parity == 1) {
+    flip_position = syndrome - 1;
+    return DecodeStatus::kCorrected;
+  }
+  if (syndrome == 0 && overall_parity == 1) {
+    flip_position = n_;
+    return DecodeStatus::kParityCorrected;
+  }
+  return DecodeStatus::kDetectedDouble;
 }
 
 }  // namespace harq
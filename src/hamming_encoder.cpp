@@ -1,10 +1,15 @@
 #include "hamming_encoder.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
+#include "bit_packing.hpp"
+#include "hamming_codec.hpp"
+
 namespace harq {
 
-HammingEncoder::HammingEncoder(int r) : r_(r), n_(0), k_(0) {
+HammingEncoder::HammingEncoder(int r)
+    : r_(r), n_(0), k_(0), data_words_(0), codeword_words_(0) {
   if (r_ < 2) {
     throw std::invalid_argument("Hamming encoder expects r >= 2.");
   }
@@ -30,6 +35,8 @@ HammingEncoder::HammingEncoder(int r) : r_(r), n_(0), k_(0) {
     basis[i] = 1;
     generator_[i] = BuildCodewordFromData(basis);
   }
+
+  BuildPackedTables();
 }
 
 int HammingEncoder::n() const { return n_; }
@@ -41,26 +48,28 @@ HammingEncoder::generator_matrix() const {
   return generator_;
 }
 
+int HammingEncoder::data_words() const { return data_words_; }
+
+int HammingEncoder::codeword_words() const { return codeword_words_; }
+
 std::vector<uint8_t> HammingEncoder::Encode(
     const std::vector<uint8_t>& data) const {
-  if (static_cast<int>(data.size()) != k_) {
-    throw std::invalid_argument("Hamming encoder expects k data bits.");
-  }
+  ValidateData(data);
 
   std::vector<uint8_t> codeword(n_, 0);
-  // Перемножение сообщения с матрицей G над GF(2).
-  for (int i = 0; i < k_; i++) {
-    uint8_t bit = data[i];
-    if (bit != 0 && bit != 1) {
-      throw std::invalid_argument("Hamming encoder expects bits 0 or 1.");
-    }
-    if (bit == 1) {
-      for (int j = 0; j < n_; j++) {
-        codeword[j] ^= generator_[i][j];
-      }
+  if (r_ <= kMaxSingleWordR) {
+    uint64_t packed = 0;
+    for (int i = 0; i < k_; i++) {
+      packed |= static_cast<uint64_t>(data[i]) << i;
     }
+    const uint64_t encoded = EncodePacked(packed);
+    UnpackBits(std::span<const uint64_t>(&encoded, 1), codeword);
+    return codeword;
   }
 
+  std::vector<uint64_t> packed_codeword(codeword_words_, 0);
+  EncodePacked(PackBits(data), packed_codeword);
+  UnpackBits(packed_codeword, codeword);
   return codeword;
 }
 
@@ -75,6 +84,98 @@ std::vector<uint8_t> HammingEncoder::EncodeExtended(
   return codeword;
 }
 
+BitVector HammingEncoder::Encode(const BitVector& data) const {
+  if (static_cast<int>(data.size()) != k_) {
+    throw std::invalid_argument("Hamming encoder expects k data bits.");
+  }
+
+  BitVector codeword(n_);
+  if (r_ <= kMaxSingleWordR) {
+    codeword.words()[0] = EncodePacked(data.words()[0]);
+  } else {
+    EncodePacked(data.words(), codeword.words());
+  }
+  return codeword;
+}
+
+BitVector HammingEncoder::EncodeExtended(const BitVector& data) const {
+  BitVector codeword = Encode(data);
+  codeword.PushBack(static_cast<int>(codeword.Popcount() & 1));
+  return codeword;
+}
+
+uint64_t HammingEncoder::EncodePacked(uint64_t data) const {
+  if (r_ > kMaxSingleWordR) {
+    throw std::invalid_argument(
+        "Single-word packed encoding expects r <= 6.");
+  }
+
+  return VisitHammingCodec(
+      r_, [data](auto codec) { return decltype(codec)::Encode(data); });
+}
+
+uint64_t HammingEncoder::EncodeExtendedPacked(uint64_t data) const {
+  if (r_ > kMaxSingleWordR) {
+    throw std::invalid_argument(
+        "Single-word packed encoding expects r <= 6.");
+  }
+
+  return VisitHammingCodec(r_, [data](auto codec) {
+    return decltype(codec)::EncodeExtended(data);
+  });
+}
+
+void HammingEncoder::EncodePacked(std::span<const uint64_t> data,
+                                  std::span<uint64_t> codeword) const {
+  if (static_cast<int>(data.size()) < data_words_ ||
+      static_cast<int>(codeword.size()) < codeword_words_) {
+    throw std::invalid_argument("Packed Hamming buffers are too small.");
+  }
+
+  if (r_ <= kMaxSingleWordR) {
+    codeword[0] = EncodePacked(data[0]);
+    return;
+  }
+
+  std::fill(codeword.begin(), codeword.begin() + codeword_words_, 0);
+
+  // Информационные биты занимают отрезки [2^j + 1, 2^(j+1) - 1] позиций.
+  std::size_t data_offset = 0;
+  for (int j = 1; j < r_; j++) {
+    const std::size_t run = (std::size_t{1} << j) - 1;
+    CopyBits(data, data_offset, codeword, std::size_t{1} << j, run);
+    data_offset += run;
+  }
+
+  for (int j = 0; j < r_; j++) {
+    const uint64_t* mask = &parity_masks_[j * codeword_words_];
+    int ones = 0;
+    for (int w = 0; w < codeword_words_; w++) {
+      ones += std::popcount(codeword[w] & mask[w]);
+    }
+    if ((ones & 1) != 0) {
+      FlipBit(codeword, (std::size_t{1} << j) - 1);
+    }
+  }
+}
+
+void HammingEncoder::EncodeExtendedPacked(std::span<const uint64_t> data,
+                                          std::span<uint64_t> codeword) const {
+  if (r_ <= kMaxSingleWordR) {
+    codeword[0] = EncodeExtendedPacked(data[0]);
+    return;
+  }
+
+  EncodePacked(data, codeword);
+  int ones = 0;
+  for (int w = 0; w < codeword_words_; w++) {
+    ones += std::popcount(codeword[w]);
+  }
+  if ((ones & 1) != 0) {
+    FlipBit(codeword, n_);
+  }
+}
+
 bool HammingEncoder::IsPowerOfTwo(int value) {
   return value > 0 && (value & (value - 1)) == 0;
 }
@@ -113,4 +214,31 @@ std::vector<uint8_t> HammingEncoder::BuildCodewordFromData(
   return codeword;
 }
 
+void HammingEncoder::ValidateData(const std::vector<uint8_t>& data) const {
+  if (static_cast<int>(data.size()) != k_) {
+    throw std::invalid_argument("Hamming encoder expects k data bits.");
+  }
+  for (uint8_t bit : data) {
+    if (bit != 0 && bit != 1) {
+      throw std::invalid_argument("Hamming encoder expects bits 0 or 1.");
+    }
+  }
+}
+
+void HammingEncoder::BuildPackedTables() {
+  data_words_ = static_cast<int>(PackedWordCount(k_));
+  codeword_words_ = static_cast<int>(PackedWordCount(n_ + 1));
+
+  parity_masks_.assign(static_cast<std::size_t>(r_) * codeword_words_, 0);
+  for (int j = 0; j < r_; j++) {
+    std::span<uint64_t> mask(&parity_masks_[j * codeword_words_],
+                             codeword_words_);
+    for (int pos = 1; pos <= n_; pos++) {
+      if (pos != (1 << j) && (pos & (1 << j)) != 0) {
+        FlipBit(mask, pos - 1);
+      }
+    }
+  }
+}
+
 }  // namespace harq
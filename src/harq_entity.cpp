@@ -0,0 +1,161 @@
+#include "harq_entity.hpp"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+#include "instrumentation.hpp"
+#include "soft_metric.hpp"
+
+namespace harq {
+
+namespace {
+
+constexpr std::size_t kCacheLine = 64;
+constexpr std::size_t kDoublesPerLine = kCacheLine / sizeof(double);
+
+}  // namespace
+
+void HarqEntity::AlignedDelete::operator()(double* data) const {
+  ::operator delete[](data, std::align_val_t{kCacheLine});
+}
+
+HarqEntity::HarqEntity(int processes, int r, int d, ProbeAlgorithm algorithm,
+                       int max_rounds, bool extended)
+    : decoder_(r, d, algorithm), capacity_(processes),
+      length_(decoder_.n() + (extended ? 1 : 0)),
+      stride_((length_ + kDoublesPerLine - 1) / kDoublesPerLine *
+              kDoublesPerLine),
+      max_rounds_(max_rounds) {
+  if (capacity_ <= 0) {
+    throw std::invalid_argument("HARQ entity needs at least one process.");
+  }
+  if (max_rounds_ <= 0) {
+    throw std::invalid_argument("HARQ process needs at least one round.");
+  }
+
+  const std::size_t values = stride_ * capacity_;
+  soft_.reset(static_cast<double*>(::operator new[](
+      values * sizeof(double), std::align_val_t{kCacheLine})));
+  std::fill_n(soft_.get(), values, 0.0);
+
+  decoded_.assign(static_cast<std::size_t>(capacity_) * decoder_.k(), 0);
+  rounds_.assign(capacity_, 0);
+  active_.assign(capacity_, 0);
+  pending_index_.assign(capacity_, -1);
+  pending_.reserve(capacity_);
+  // Стек свободных номеров: первым выдаётся процесс 0.
+  free_.reserve(capacity_);
+  for (int id = capacity_ - 1; id >= 0; id--) {
+    free_.push_back(id);
+  }
+}
+
+int HarqEntity::capacity() const { return capacity_; }
+
+int HarqEntity::active() const {
+  return capacity_ - static_cast<int>(free_.size());
+}
+
+int HarqEntity::n() const { return decoder_.n(); }
+
+int HarqEntity::k() const { return decoder_.k(); }
+
+int HarqEntity::length() const { return length_; }
+
+std::size_t HarqEntity::stride() const { return stride_; }
+
+int HarqEntity::max_rounds() const { return max_rounds_; }
+
+int HarqEntity::Allocate() {
+  if (free_.empty()) {
+    return -1;
+  }
+  const int process = free_.back();
+  free_.pop_back();
+  active_[process] = 1;
+  rounds_[process] = 0;
+  std::fill_n(soft_.get() + process * stride_, length_, 0.0);
+  // Решение прежнего владельца номера не должно быть видно до первого
+  // декодирования.
+  std::fill_n(decoded_.begin() + static_cast<std::size_t>(process) * k(), k(),
+              0);
+  return process;
+}
+
+void HarqEntity::Release(int process) {
+  CheckActive(process);
+  // Процесс, ожидающий декодирования, убирается из очереди заменой
+  // последним элементом.
+  const int index = pending_index_[process];
+  if (index >= 0) {
+    const int last = pending_.back();
+    pending_[index] = last;
+    pending_index_[last] = index;
+    pending_.pop_back();
+    pending_index_[process] = -1;
+  }
+  active_[process] = 0;
+  free_.push_back(process);
+}
+
+void HarqEntity::Receive(int process, std::span<const double> llr,
+                         double scale) {
+  CheckActive(process);
+  if (static_cast<int>(llr.size()) != length_) {
+    throw std::invalid_argument("HARQ process expects length() LLR values.");
+  }
+  if (rounds_[process] >= max_rounds_) {
+    throw std::invalid_argument("HARQ round budget is exhausted.");
+  }
+  {
+    HARQ_STAGE(kCombine);
+    AccumulateLlr(std::span<double>(soft_.get() + process * stride_, length_),
+                  llr, scale);
+  }
+  rounds_[process]++;
+  if (pending_index_[process] < 0) {
+    pending_index_[process] = static_cast<int>(pending_.size());
+    pending_.push_back(process);
+  }
+}
+
+int HarqEntity::ProcessSlot() {
+  const int k = decoder_.k();
+  // Обход по возрастанию номера идёт по области буферов последовательно.
+  std::sort(pending_.begin(), pending_.end());
+  for (int process : pending_) {
+    decoder_.Decode(soft_buffer(process),
+                    std::span<uint8_t>(decoded_).subspan(
+                        static_cast<std::size_t>(process) * k, k));
+    pending_index_[process] = -1;
+  }
+  const int decoded = static_cast<int>(pending_.size());
+  pending_.clear();
+  return decoded;
+}
+
+int HarqEntity::rounds(int process) const {
+  CheckActive(process);
+  return rounds_[process];
+}
+
+std::span<const double> HarqEntity::soft_buffer(int process) const {
+  CheckActive(process);
+  return std::span<const double>(soft_.get() + process * stride_, length_);
+}
+
+std::span<const uint8_t> HarqEntity::decoded(int process) const {
+  CheckActive(process);
+  const int k = decoder_.k();
+  return std::span<const uint8_t>(decoded_).subspan(
+      static_cast<std::size_t>(process) * k, k);
+}
+
+void HarqEntity::CheckActive(int process) const {
+  if (process < 0 || process >= capacity_ || !active_[process]) {
+    throw std::invalid_argument("HARQ process is not allocated.");
+  }
+}
+
+}  // namespace harq
@@ -0,0 +1,201 @@
+#include "harq_process.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "instrumentation.hpp"
+#include "soft_metric.hpp"
+
+namespace harq {
+
+HarqProcess::HarqProcess(int r, int d, ProbeAlgorithm algorithm,
+                         int max_rounds, bool extended, HarqMode mode)
+    : decoder_(r, d, algorithm), max_rounds_(max_rounds),
+      length_(decoder_.n() + (extended ? 1 : 0)), mode_(mode), round_(0) {
+  if (max_rounds_ <= 0) {
+    throw std::invalid_argument("HARQ process needs at least one round.");
+  }
+  if (mode_ == HarqMode::kIncrementalRedundancy && !extended) {
+    throw std::invalid_argument(
+        "Incremental redundancy needs the extended code.");
+  }
+  BuildPuncturing(r);
+  soft_.assign(length_, 0.0);
+  received_.assign(length_, 0.0);
+  decoded_.assign(decoder_.k(), 0);
+}
+
+int HarqProcess::n() const { return decoder_.n(); }
+
+int HarqProcess::k() const { return decoder_.k(); }
+
+int HarqProcess::length() const { return length_; }
+
+int HarqProcess::max_rounds() const { return max_rounds_; }
+
+int HarqProcess::round() const { return round_; }
+
+HarqMode HarqProcess::mode() const { return mode_; }
+
+std::span<const int> HarqProcess::RoundPositions(int round) const {
+  if (round < 0 || round >= max_rounds_) {
+    throw std::invalid_argument("HARQ round is out of range.");
+  }
+  return std::span<const int>(round_positions_)
+      .subspan(round_offsets_[round],
+               round_offsets_[round + 1] - round_offsets_[round]);
+}
+
+void HarqProcess::SetQuantizer(const LlrQuantizer& quantizer) {
+  if (quantizer.bits() > 8) {
+    throw std::invalid_argument("HARQ soft buffer holds at most 8-bit LLRs.");
+  }
+  quantizer_ = quantizer;
+  soft_fixed_.assign(length_, 0);
+  received_fixed_.assign(length_, 0);
+  Reset();
+}
+
+bool HarqProcess::quantized() const { return quantizer_.has_value(); }
+
+void HarqProcess::Reset() {
+  std::fill(soft_.begin(), soft_.end(), 0.0);
+  std::fill(soft_fixed_.begin(), soft_fixed_.end(), 0);
+  round_ = 0;
+}
+
+void HarqProcess::Receive(std::span<const double> llr) {
+  if (round_ >= max_rounds_) {
+    throw std::invalid_argument("HARQ round budget is exhausted.");
+  }
+  if (static_cast<int>(llr.size()) !=
+      round_offsets_[round_ + 1] - round_offsets_[round_]) {
+    throw std::invalid_argument(
+        "HARQ process expects one LLR per transmitted position.");
+  }
+  CombineAndDecode(llr, 1.0);
+}
+
+HarqResult HarqProcess::Transmit(std::span<const uint8_t> data,
+                                 std::span<const double> symbols,
+                                 AwgnChannel& channel) {
+  if (static_cast<int>(data.size()) != decoder_.k()) {
+    throw std::invalid_argument("HARQ process expects k data bits.");
+  }
+  if (static_cast<int>(symbols.size()) != length_) {
+    throw std::invalid_argument("HARQ process expects length() symbols.");
+  }
+
+  Reset();
+  const double scale = 2.0 / channel.noise_variance();
+  int sent = 0;
+  while (round_ < max_rounds_) {
+    const std::span<const int> positions = RoundPositions(round_);
+    const std::span<double> received =
+        std::span<double>(received_).first(positions.size());
+    for (std::size_t i = 0; i < positions.size(); i++) {
+      received[i] = symbols[positions[i]];
+    }
+    channel.AddNoiseInPlace(received);
+    sent += static_cast<int>(positions.size());
+    CombineAndDecode(received, scale);
+    if (std::equal(data.begin(), data.end(), decoded_.begin())) {
+      HARQ_COUNT(kHarqSuccesses, 1);
+      HARQ_COUNT_SUCCESS_ROUNDS(round_);
+      return {true, round_, sent};
+    }
+  }
+  HARQ_COUNT(kHarqFailures, 1);
+  return {false, round_, sent};
+}
+
+std::span<const double> HarqProcess::soft_buffer() const { return soft_; }
+
+std::span<const int8_t> HarqProcess::quantized_buffer() const {
+  return soft_fixed_;
+}
+
+std::span<const uint8_t> HarqProcess::decoded() const { return decoded_; }
+
+void HarqProcess::BuildPuncturing(int r) {
+  round_offsets_.assign(1, 0);
+  if (mode_ == HarqMode::kChaseCombining) {
+    for (int t = 0; t < max_rounds_; t++) {
+      for (int i = 0; i < length_; i++) {
+        round_positions_.push_back(i);
+      }
+      round_offsets_.push_back(static_cast<int>(round_positions_.size()));
+    }
+    return;
+  }
+
+  // Кольцевой буфер: данные, первые ceil(r/2) паритетов, остальные
+  // паритеты, общий паритет. Индекс i буфера — позиция i+1 кода, паритет
+  // 2^j лежит в индексе 2^j - 1, общий паритет — в индексе n.
+  const int first_parity = (r + 1) / 2;
+  std::vector<int> circular;
+  circular.reserve(length_);
+  for (int i = 0; i < decoder_.n(); i++) {
+    if (((i + 1) & i) != 0) {
+      circular.push_back(i);
+    }
+  }
+  for (int j = 0; j < r; j++) {
+    circular.push_back((1 << j) - 1);
+  }
+  circular.push_back(decoder_.n());
+
+  // Первый раунд — данные и first_parity паритетов, каждый следующий
+  // читает из кольца окно, дополняющее предыдущее до полного слова.
+  const int first_length = decoder_.k() + first_parity;
+  int start = 0;
+  for (int t = 0; t < max_rounds_; t++) {
+    const int window = t % 2 == 0 ? first_length : length_ - first_length;
+    for (int i = 0; i < window; i++) {
+      round_positions_.push_back(circular[(start + i) % length_]);
+    }
+    start = (start + window) % length_;
+    round_offsets_.push_back(static_cast<int>(round_positions_.size()));
+  }
+}
+
+void HarqProcess::CombineAndDecode(std::span<const double> llr,
+                                   double scale) {
+  const std::span<const int> positions = RoundPositions(round_);
+  round_++;
+
+  if (quantizer_) {
+    {
+      HARQ_STAGE(kCombine);
+      const std::span<int8_t> quantized =
+          std::span<int8_t>(received_fixed_).first(llr.size());
+      quantizer_->Quantize(llr, quantized, scale);
+      const int limit = quantizer_->max_level();
+      if (mode_ == HarqMode::kChaseCombining) {
+        AccumulateLlrSaturated(soft_fixed_, quantized, limit);
+      } else {
+        for (std::size_t i = 0; i < positions.size(); i++) {
+          const int sum = soft_fixed_[positions[i]] + quantized[i];
+          soft_fixed_[positions[i]] =
+              static_cast<int8_t>(std::clamp(sum, -limit, limit));
+        }
+      }
+    }
+    decoder_.Decode(std::span<const int8_t>(soft_fixed_), decoded_);
+    return;
+  }
+
+  {
+    HARQ_STAGE(kCombine);
+    if (mode_ == HarqMode::kChaseCombining) {
+      AccumulateLlr(soft_, llr, scale);
+    } else {
+      for (std::size_t i = 0; i < positions.size(); i++) {
+        soft_[positions[i]] += scale * llr[i];
+      }
+    }
+  }
+  decoder_.Decode(std::span<const double>(soft_), decoded_);
+}
+
+}  // namespace harq
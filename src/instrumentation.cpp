@@ -0,0 +1,105 @@
+#include "instrumentation.hpp"
+
+namespace harq::instrumentation {
+
+namespace internal {
+
+namespace {
+
+std::atomic<ThreadBlock*> head{nullptr};
+
+// Возвращает блок в общий список при завершении потока.
+struct BlockRelease {
+  ThreadBlock* block = nullptr;
+  ~BlockRelease() {
+    if (block != nullptr) {
+      block->in_use.store(false, std::memory_order_release);
+    }
+  }
+};
+
+thread_local BlockRelease release;
+
+}  // namespace
+
+thread_local ThreadBlock* local_block = nullptr;
+
+ThreadBlock* AcquireBlock() {
+  // Сначала — блок завершившегося потока: его значения остаются в сумме.
+  ThreadBlock* block = head.load(std::memory_order_acquire);
+  for (; block != nullptr; block = block->next) {
+    bool expected = false;
+    if (block->in_use.compare_exchange_strong(expected, true,
+                                              std::memory_order_acquire)) {
+      break;
+    }
+  }
+  if (block == nullptr) {
+    block = new ThreadBlock;
+    block->in_use.store(true, std::memory_order_relaxed);
+    block->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(block->next, block,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+  release.block = block;
+  local_block = block;
+  return block;
+}
+
+}  // namespace internal
+
+double Snapshot::cycles_per_call(Stage stage) const {
+  const int index = static_cast<int>(stage);
+  return stage_calls[index] == 0
+             ? 0.0
+             : static_cast<double>(stage_cycles[index]) / stage_calls[index];
+}
+
+double Snapshot::mean_success_rounds() const {
+  uint64_t successes = 0;
+  uint64_t rounds = 0;
+  for (int bin = 0; bin < kRoundBins; bin++) {
+    successes += success_rounds[bin];
+    rounds += success_rounds[bin] * (bin + 1);
+  }
+  return successes == 0 ? 0.0 : static_cast<double>(rounds) / successes;
+}
+
+Snapshot Collect() {
+  Snapshot snapshot;
+  for (internal::ThreadBlock* block =
+           internal::head.load(std::memory_order_acquire);
+       block != nullptr; block = block->next) {
+    auto value = [block](int slot) {
+      return block->values[slot].load(std::memory_order_relaxed);
+    };
+    for (int i = 0; i < kCounterCount; i++) {
+      snapshot.counters[i] += value(internal::kCounterSlot + i);
+    }
+    for (int i = 0; i < kStatusCount; i++) {
+      snapshot.statuses[i] += value(internal::kStatusSlot + i);
+    }
+    for (int i = 0; i < kRoundBins; i++) {
+      snapshot.success_rounds[i] += value(internal::kRoundSlot + i);
+    }
+    for (int i = 0; i < kStageCount; i++) {
+      snapshot.stage_cycles[i] += value(internal::kCyclesSlot + i);
+      snapshot.stage_calls[i] += value(internal::kCallsSlot + i);
+    }
+  }
+  return snapshot;
+}
+
+void Reset() {
+  for (internal::ThreadBlock* block =
+           internal::head.load(std::memory_order_acquire);
+       block != nullptr; block = block->next) {
+    for (auto& cell : block->values) {
+      cell.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace harq::instrumentation
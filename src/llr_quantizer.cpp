@@ -0,0 +1,70 @@
+#include "llr_quantizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace harq {
+
+namespace {
+
+// Отрицательные значения меньше половины уровня округляются до -1, а не
+// до 0: уровень 0 даёт жёсткое решение 1, и знак бы потерялся.
+long QuantizeValue(double value, double limit) {
+  // Ограничение до округления исключает переполнение при больших LLR.
+  const double clamped = std::clamp(value, -limit, limit);
+  const long level = std::lround(clamped);
+  return level - static_cast<long>(clamped < 0.0 && level == 0);
+}
+
+template <typename T>
+void QuantizeAll(std::span<const double> llr, std::span<T> out,
+                 double factor, int max_level) {
+  if (llr.size() != out.size()) {
+    throw std::invalid_argument("LLR and output sizes must match.");
+  }
+  const double limit = max_level;
+  for (std::size_t i = 0; i < llr.size(); i++) {
+    out[i] = static_cast<T>(QuantizeValue(llr[i] * factor, limit));
+  }
+}
+
+}  // namespace
+
+LlrQuantizer::LlrQuantizer(int bits, double scale)
+    : bits_(bits), scale_(scale), max_level_(0) {
+  if (bits_ < 2 || bits_ > 16) {
+    throw std::invalid_argument("LLR bit width must be in [2, 16].");
+  }
+  if (!std::isfinite(scale_) || scale_ <= 0.0) {
+    throw std::invalid_argument("LLR scale must be positive.");
+  }
+  max_level_ = (1 << (bits_ - 1)) - 1;
+}
+
+int LlrQuantizer::bits() const { return bits_; }
+
+double LlrQuantizer::scale() const { return scale_; }
+
+int LlrQuantizer::max_level() const { return max_level_; }
+
+int LlrQuantizer::Quantize(double llr) const {
+  return static_cast<int>(QuantizeValue(llr * scale_, max_level_));
+}
+
+double LlrQuantizer::Dequantize(int level) const { return level / scale_; }
+
+void LlrQuantizer::Quantize(std::span<const double> llr,
+                            std::span<int8_t> out, double gain) const {
+  if (bits_ > 8) {
+    throw std::invalid_argument("int8_t output needs bit width <= 8.");
+  }
+  QuantizeAll(llr, out, gain * scale_, max_level_);
+}
+
+void LlrQuantizer::Quantize(std::span<const double> llr,
+                            std::span<int16_t> out, double gain) const {
+  QuantizeAll(llr, out, gain * scale_, max_level_);
+}
+
+}  // namespace harq
@@ -0,0 +1,194 @@
+#include "noise_generator.hpp"
+
+#include <bit>
+#include <cmath>
+
+namespace harq {
+
+namespace {
+
+constexpr int kLayers = 128;
+// Правая граница основания и площадь слоя зиккурата для 128 слоёв.
+constexpr double kZigguratR = 3.442619855899;
+constexpr double kZigguratV = 9.91256303526217e-3;
+constexpr double kTwoPow53Inv = 1.0 / 9007199254740992.0;
+
+uint64_t SplitMix64(uint64_t& state) {
+  return Mix64(state += 0x9E3779B97F4A7C15ull);
+}
+
+struct ZigguratTables {
+  double x[kLayers + 1];
+  // ratio[i] = x[i+1] / x[i]: порог быстрого пути для слоя i.
+  double ratio[kLayers];
+
+  ZigguratTables() {
+    const double f = std::exp(-0.5 * kZigguratR * kZigguratR);
+    x[0] = kZigguratV / f;
+    x[1] = kZigguratR;
+    x[kLayers] = 0.0;
+    for (int i = 2; i < kLayers; i++) {
+      x[i] = std::sqrt(
+          -2.0 * std::log(kZigguratV / x[i - 1] +
+                          std::exp(-0.5 * x[i - 1] * x[i - 1])));
+    }
+    for (int i = 0; i < kLayers; i++) {
+      ratio[i] = x[i + 1] / x[i];
+    }
+  }
+};
+
+const ZigguratTables& Tables() {
+  static const ZigguratTables tables;
+  return tables;
+}
+
+}  // namespace
+
+Xoshiro256::Xoshiro256(uint64_t seed, uint64_t stream) {
+  uint64_t mix = seed;
+  uint64_t stream_mix = stream ^ 0xD1B54A32D192ED03ull;
+  uint64_t state = SplitMix64(mix) ^ SplitMix64(stream_mix);
+  for (uint64_t& word : state_) {
+    word = SplitMix64(state);
+  }
+}
+
+uint64_t Xoshiro256::Next() {
+  const uint64_t result =
+      std::rotl(state_[0] + state_[3], 23) + state_[0];
+  const uint64_t t = state_[1] << 17;
+  state_[2] ^= state_[0];
+  state_[3] ^= state_[1];
+  state_[1] ^= state_[2];
+  state_[0] ^= state_[3];
+  state_[2] ^= t;
+  state_[3] = std::rotl(state_[3], 45);
+  return result;
+}
+
+double Xoshiro256::NextDouble() {
+  return static_cast<double>(Next() >> 11) * kTwoPow53Inv;
+}
+
+void Xoshiro256::Jump() {
+  static constexpr uint64_t kJump[] = {0x180EC6D33CFD0ABAull,
+                                       0xD5A61266F0C9392Cull,
+                                       0xA9582618E03FC9AAull,
+                                       0x39ABDC4529B1661Cull};
+
+  uint64_t jumped[4] = {0, 0, 0, 0};
+  for (uint64_t word : kJump) {
+    for (int bit = 0; bit < 64; bit++) {
+      if ((word >> bit) & 1) {
+        for (int i = 0; i < 4; i++) {
+          jumped[i] ^= state_[i];
+        }
+      }
+      Next();
+    }
+  }
+  for (int i = 0; i < 4; i++) {
+    state_[i] = jumped[i];
+  }
+}
+
+GaussianNoise::GaussianNoise(uint64_t seed, uint64_t stream)
+    : engine_(seed, stream) {
+  Tables();
+}
+
+double GaussianNoise::Next() {
+  const ZigguratTables& tables = Tables();
+  const uint64_t bits = engine_.Next();
+  // Младшие 7 битов выбирают слой, старшие 53 дают u в [-1, 1).
+  const int layer = static_cast<int>(bits & (kLayers - 1));
+  const double u =
+      2.0 * static_cast<double>(bits >> 11) * kTwoPow53Inv - 1.0;
+  if (std::abs(u) < tables.ratio[layer]) {
+    return u * tables.x[layer];
+  }
+  return SampleSlow(bits);
+}
+
+double GaussianNoise::SampleSlow(uint64_t bits) {
+  const ZigguratTables& tables = Tables();
+  for (;;) {
+    const int layer = static_cast<int>(bits & (kLayers - 1));
+    const double u =
+        2.0 * static_cast<double>(bits >> 11) * kTwoPow53Inv - 1.0;
+    if (std::abs(u) < tables.ratio[layer]) {
+      return u * tables.x[layer];
+    }
+
+    if (layer == 0) {
+      // Хвост за границей R по методу Марсальи.
+      double x = 0.0;
+      double y = 0.0;
+      do {
+        x = std::log(1.0 - engine_.NextDouble()) / kZigguratR;
+        y = std::log(1.0 - engine_.NextDouble());
+      } while (-2.0 * y < x * x);
+      return u < 0.0 ? x - kZigguratR : kZigguratR - x;
+    }
+
+    const double x = u * tables.x[layer];
+    const double f0 = std::exp(-0.5 * (tables.x[layer] * tables.x[layer] -
+                                       x * x));
+    const double f1 = std::exp(
+        -0.5 * (tables.x[layer + 1] * tables.x[layer + 1] - x * x));
+    if (f1 + engine_.NextDouble() * (f0 - f1) < 1.0) {
+      return x;
+    }
+    bits = engine_.Next();
+  }
+}
+
+void GaussianNoise::Fill(std::span<double> out, double sigma) {
+  for (double& value : out) {
+    value = sigma * Next();
+  }
+}
+
+void GaussianNoise::Fill(std::span<float> out, float sigma) {
+  for (float& value : out) {
+    value = sigma * static_cast<float>(Next());
+  }
+}
+
+void GaussianNoise::AddTo(std::span<double> samples, double sigma) {
+  for (double& value : samples) {
+    value += sigma * Next();
+  }
+}
+
+void GaussianNoise::AddTo(std::span<float> samples, float sigma) {
+  for (float& value : samples) {
+    value += sigma * static_cast<float>(Next());
+  }
+}
+
+Xoshiro256& GaussianNoise::engine() { return engine_; }
+
+NoiseStream::NoiseStream(uint64_t seed, uint64_t stream)
+    : seed_(seed), stream_(stream), jumps_(0), noise_(seed, stream) {}
+
+NoiseStream NoiseStream::Fork(uint64_t child) const {
+  uint64_t stream = Mix64(stream_ * 0x9E3779B97F4A7C15ull + child + 1);
+  NoiseStream forked(seed_, stream == 0 ? 1 : stream);
+  for (uint64_t i = 0; i < jumps_; i++) {
+    forked.Jump();
+  }
+  return forked;
+}
+
+void NoiseStream::Jump() {
+  noise_.engine().Jump();
+  jumps_++;
+}
+
+void NoiseStream::AddTo(std::span<double> samples, double sigma) {
+  noise_.AddTo(samples, sigma);
+}
+
+}  // namespace harq
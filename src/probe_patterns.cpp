@@ -0,0 +1,177 @@
+#include "probe_patterns.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <tuple>
+
+namespace harq {
+
+namespace {
+
+// Ограничение на размер таблицы (как у ChaseDecoder).
+constexpr long long kMaxPatterns = 1 << 20;
+
+long long Binomial(int n, int m) {
+  long long result = 1;
+  for (int i = 1; i <= m; i++) {
+    result = result * (n - m + i) / i;
+    if (result > kMaxPatterns) {
+      return result;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+ProbePatternTable::ProbePatternTable(int n, int d, ProbeAlgorithm algorithm)
+    : n_(n), d_(d), algorithm_(algorithm), ranks_(0) {
+  offsets_.push_back(0);
+  auto close_pattern = [this] {
+    offsets_.push_back(static_cast<int>(entries_.size()));
+  };
+
+  switch (algorithm_) {
+    case ProbeAlgorithm::First: {
+      const int ones_count = d / 2;
+      if (ones_count == 0) {
+        throw std::invalid_argument("Wrong input data: d should be >= 0");
+      }
+      if (ones_count > n) {
+        throw std::invalid_argument("Wrong input data: d/2 > n");
+      }
+      if (Binomial(n, ones_count) + 1 > kMaxPatterns) {
+        throw std::invalid_argument("Too many Chase test patterns.");
+      }
+      // Нулевая последовательность, затем все маски веса d/2 в порядке
+      // std::next_permutation, начиная с единиц в конце.
+      close_pattern();
+      std::vector<uint8_t> mask(n, 0);
+      std::fill(mask.end() - ones_count, mask.end(), 1);
+      do {
+        for (int i = 0; i < n; i++) {
+          if (mask[i]) {
+            entries_.push_back(i);
+          }
+        }
+        close_pattern();
+      } while (std::next_permutation(mask.begin(), mask.end()));
+      break;
+    }
+    case ProbeAlgorithm::Second: {
+      if (n <= 0 || d <= 0) {
+        throw std::invalid_argument("Reliability values are incorrect.");
+      }
+      ranks_ = d / 2;
+      if (ranks_ > n) {
+        throw std::invalid_argument("Wrong input data: d/2 > n");
+      }
+      if (ranks_ > 20) {
+        throw std::invalid_argument("Too many Chase test patterns.");
+      }
+      // Маска m ставит единицы на ранги, соответствующие её битам.
+      for (int mask = 0; mask < (1 << ranks_); mask++) {
+        for (int i = 0; i < ranks_; i++) {
+          if ((mask >> i) & 1) {
+            entries_.push_back(i);
+          }
+        }
+        close_pattern();
+      }
+      break;
+    }
+    case ProbeAlgorithm::Third: {
+      if (n <= 0 || d <= 0) {
+        throw std::invalid_argument("Reliability values are incorrect.");
+      }
+      ranks_ = d - 1;
+      if (ranks_ > n) {
+        throw std::invalid_argument("Wrong input data: d-1 > n");
+      }
+      if (ranks_ == 0) {
+        throw std::invalid_argument("Reliability values are incorrect.");
+      }
+      // Нечётное d — ранги 0, 2, 4, ...; чётное — 0, 1, 3, 5, ...
+      if (d % 2 == 1) {
+        for (int i = 0; i < ranks_; i += 2) {
+          entries_.push_back(i);
+        }
+      } else {
+        for (int i = 0; i < std::min(ranks_, 2); i++) {
+          entries_.push_back(i);
+        }
+        for (int i = 3; i < ranks_; i += 2) {
+          entries_.push_back(i);
+        }
+      }
+      close_pattern();
+      break;
+    }
+    case ProbeAlgorithm::ThirdNested: {
+      if (n <= 0 || d <= 0) {
+        throw std::invalid_argument("Reliability values are incorrect.");
+      }
+      ranks_ = d - 1;
+      if (ranks_ > n) {
+        throw std::invalid_argument("Wrong input data: d-1 > n");
+      }
+      if (ranks_ == 0) {
+        throw std::invalid_argument("Reliability values are incorrect.");
+      }
+      // Каждая последовательность — префикс рангов 0 .. m-1.
+      close_pattern();
+      for (int m = d % 2 == 1 ? 2 : 1; m <= ranks_; m += 2) {
+        for (int i = 0; i < m; i++) {
+          entries_.push_back(i);
+        }
+        close_pattern();
+      }
+      break;
+    }
+    default:
+      throw std::invalid_argument("Wrong probe algorithm chosen");
+  }
+}
+
+int ProbePatternTable::n() const { return n_; }
+
+int ProbePatternTable::d() const { return d_; }
+
+ProbeAlgorithm ProbePatternTable::algorithm() const { return algorithm_; }
+
+int ProbePatternTable::size() const {
+  return static_cast<int>(offsets_.size()) - 1;
+}
+
+int ProbePatternTable::ranks() const { return ranks_; }
+
+std::span<const int> ProbePatternTable::Pattern(int index) const {
+  return std::span<const int>(entries_).subspan(
+      offsets_[index], offsets_[index + 1] - offsets_[index]);
+}
+
+std::shared_ptr<const ProbePatternTable> GetProbePatterns(
+    int n, int d, ProbeAlgorithm algorithm) {
+  using Key = std::tuple<int, int, ProbeAlgorithm>;
+  static std::shared_mutex mutex;
+  static std::map<Key, std::shared_ptr<const ProbePatternTable>> cache;
+
+  const Key key(n, d, algorithm);
+  {
+    std::shared_lock lock(mutex);
+    const auto it = cache.find(key);
+    if (it != cache.end()) {
+      return it->second;
+    }
+  }
+
+  // Таблица строится без блокировки; при гонке остаётся первая вставленная.
+  auto table = std::make_shared<const ProbePatternTable>(n, d, algorithm);
+  std::unique_lock lock(mutex);
+  return cache.emplace(key, std::move(table)).first->second;
+}
+
+}  // namespace harq
@@ -0,0 +1,21 @@
+#pragma once
+
+// Внутренний заголовок библиотеки: общие условия сборки векторных ядер.
+// Ядра x86 компилируются с __attribute__((target("avx2"))) и выбираются
+// во время выполнения, поэтому -mavx2 для всей сборки не нужен.
+
+#include "soft_metric.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HARQ_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace harq {
+
+// AVX2 запрошен вызывающей стороной и поддерживается процессором.
+inline bool UseAvx2(SimdLevel level) {
+  return level == SimdLevel::kAvx2 && DetectSimdLevel() == SimdLevel::kAvx2;
+}
+
+}  // namespace harq
@@ -0,0 +1,343 @@
+#include "simulator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "awgn_channel.hpp"
+#include "bit_packing.hpp"
+#include "bpsk.hpp"
+#include "chase_decoder.hpp"
+#include "hamming_decoder.hpp"
+#include "hamming_encoder.hpp"
+#include "harq_process.hpp"
+#include "llr_quantizer.hpp"
+#include "noise_generator.hpp"
+
+namespace harq {
+
+namespace {
+
+// Квантиль нормального распределения для 95% доверительного интервала.
+constexpr double kZ95 = 1.959963984540054;
+
+// Счётчики точки общие для всех потоков и обновляются без блокировок.
+struct PointState {
+  std::atomic<uint64_t> next_batch{0};
+  std::atomic<uint64_t> frames{0};
+  std::atomic<uint64_t> frame_errors{0};
+  std::atomic<uint64_t> bit_errors{0};
+  std::atomic<uint64_t> channel_symbols{0};
+  std::atomic<bool> stop{false};
+};
+
+bool PointDone(const SimulationConfig& config, uint64_t frames,
+               uint64_t frame_errors) {
+  if (config.target_frame_errors > 0 &&
+      frame_errors >= config.target_frame_errors) {
+    return true;
+  }
+  if (config.target_relative_ci > 0.0 && frame_errors > 0) {
+    const double fer = static_cast<double>(frame_errors) / frames;
+    const double half_width = kZ95 * std::sqrt(fer * (1.0 - fer) / frames);
+    return half_width <= config.target_relative_ci * fer;
+  }
+  return false;
+}
+
+struct FrameResult {
+  int bit_errors;
+  int channel_symbols;
+};
+
+// Рабочее пространство потока: все буферы выделяются заранее.
+class FrameWorker {
+ public:
+  FrameWorker(const SimulationConfig& config, Scheme scheme)
+      : scheme_(scheme),
+        extended_(config.extended || scheme == Scheme::kHarqIr),
+        encoder_(config.r), decoder_(config.r),
+        length_(encoder_.n() + (extended_ ? 1 : 0)) {
+    switch (scheme_) {
+      case Scheme::kChase1:
+        chase_.emplace(config.r, config.chase_d, ProbeAlgorithm::First);
+        break;
+      case Scheme::kChase2:
+        chase_.emplace(config.r, config.chase_d, ProbeAlgorithm::Second);
+        break;
+      case Scheme::kChase3:
+        chase_.emplace(config.r, config.chase_d,
+                       ProbeAlgorithm::ThirdNested);
+        break;
+      case Scheme::kHarqChase:
+        harq_.emplace(config.r, config.chase_d, config.harq_algorithm,
+                      config.harq_max_rounds, config.extended);
+        break;
+      case Scheme::kHarqIr:
+        harq_.emplace(config.r, config.chase_d, config.harq_algorithm,
+                      config.harq_max_rounds, true,
+                      HarqMode::kIncrementalRedundancy);
+        break;
+      case Scheme::kHardHamming:
+        break;
+    }
+    if (config.llr_bits > 0) {
+      const LlrQuantizer quantizer(config.llr_bits, config.llr_scale);
+      if (harq_) {
+        harq_->SetQuantizer(quantizer);
+      } else {
+        quantizer_.emplace(quantizer);
+      }
+    }
+    data_.assign(encoder_.data_words(), 0);
+    decoded_.assign(encoder_.data_words(), 0);
+    codeword_.assign(encoder_.codeword_words(), 0);
+    hard_.assign(encoder_.codeword_words(), 0);
+    llr_.assign(length_, 0.0);
+    llr_fixed_.assign(length_, 0);
+    data_bits_.assign(encoder_.k(), 0);
+    decoded_bits_.assign(encoder_.k(), 0);
+  }
+
+  int k() const { return encoder_.k(); }
+
+  // Передаёт один случайный кадр.
+  FrameResult RunFrame(Xoshiro256& data_rng, AwgnChannel& channel) {
+    const int k = encoder_.k();
+    for (uint64_t& word : data_) {
+      word = data_rng.Next();
+    }
+    data_.back() &= LowBitsMask(k - 64 * (encoder_.data_words() - 1));
+
+    if (extended_) {
+      encoder_.EncodeExtendedPacked(data_, codeword_);
+    } else {
+      encoder_.EncodePacked(data_, codeword_);
+    }
+    BpskMapPacked(codeword_, llr_);
+
+    if (harq_) {
+      // llr_ хранит символы BPSK; шум и объединение выполняет процесс.
+      UnpackBits(data_, data_bits_);
+      const HarqResult result = harq_->Transmit(data_bits_, llr_, channel);
+      int errors = 0;
+      if (!result.success) {
+        const std::span<const uint8_t> decoded = harq_->decoded();
+        for (int i = 0; i < k; i++) {
+          errors += decoded[i] != data_bits_[i];
+        }
+      }
+      return {errors, result.symbols};
+    }
+
+    channel.AddNoiseInPlace(llr_);
+    BpskDemapSoft(llr_, channel.noise_variance());
+
+    int errors = 0;
+    if (chase_) {
+      if (quantizer_) {
+        quantizer_->Quantize(llr_, llr_fixed_);
+        chase_->Decode(std::span<const int16_t>(llr_fixed_), decoded_bits_);
+      } else {
+        chase_->Decode(std::span<const double>(llr_), decoded_bits_);
+      }
+      for (int i = 0; i < k; i++) {
+        errors += decoded_bits_[i] != GetBit(data_, i);
+      }
+      return {errors, length_};
+    }
+
+    BpskDemapPacked(llr_, hard_);
+    decoder_.DecodePacked(hard_, extended_, decoded_);
+    for (std::size_t w = 0; w < data_.size(); w++) {
+      errors += std::popcount(decoded_[w] ^ data_[w]);
+    }
+    return {errors, length_};
+  }
+
+ private:
+  Scheme scheme_;
+  bool extended_;
+  HammingEncoder encoder_;
+  HammingDecoder decoder_;
+  int length_;
+  std::optional<ChaseDecoder> chase_;
+  std::optional<HarqProcess> harq_;
+  std::optional<LlrQuantizer> quantizer_;
+
+  std::vector<uint64_t> data_;
+  std::vector<uint64_t> decoded_;
+  std::vector<uint64_t> codeword_;
+  std::vector<uint64_t> hard_;
+  std::vector<double> llr_;
+  std::vector<int16_t> llr_fixed_;
+  std::vector<uint8_t> data_bits_;
+  std::vector<uint8_t> decoded_bits_;
+};
+
+void RunWorker(const SimulationConfig& config, const AwgnChannel& base,
+               FrameWorker& worker, PointState& state) {
+  const uint64_t batch_frames = static_cast<uint64_t>(config.batch_frames);
+
+  while (!state.stop.load(std::memory_order_relaxed)) {
+    const uint64_t batch =
+        state.next_batch.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t first = batch * batch_frames;
+    if (first >= config.max_frames) {
+      break;
+    }
+    const uint64_t count = std::min(batch_frames, config.max_frames - first);
+
+    // Подпоследовательности зависят только от номера пакета: шум — поток
+    // потомка batch базового канала, данные — поток batch после прыжка на
+    // 2^128.
+    AwgnChannel channel = base.Fork(batch);
+    Xoshiro256 data_rng(config.seed, batch);
+    data_rng.Jump();
+
+    uint64_t frame_errors = 0;
+    uint64_t bit_errors = 0;
+    uint64_t channel_symbols = 0;
+    for (uint64_t f = 0; f < count; f++) {
+      const FrameResult result = worker.RunFrame(data_rng, channel);
+      bit_errors += result.bit_errors;
+      frame_errors += result.bit_errors != 0;
+      channel_symbols += result.channel_symbols;
+    }
+
+    state.bit_errors.fetch_add(bit_errors, std::memory_order_relaxed);
+    state.channel_symbols.fetch_add(channel_symbols,
+                                    std::memory_order_relaxed);
+    const uint64_t total_errors =
+        state.frame_errors.fetch_add(frame_errors, std::memory_order_relaxed) +
+        frame_errors;
+    const uint64_t total_frames =
+        state.frames.fetch_add(count, std::memory_order_relaxed) + count;
+    if (PointDone(config, total_frames, total_errors)) {
+      state.stop.store(true, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace
+
+std::string SchemeName(Scheme scheme) {
+  switch (scheme) {
+    case Scheme::kHardHamming:
+      return "hard";
+    case Scheme::kChase1:
+      return "chase1";
+    case Scheme::kChase2:
+      return "chase2";
+    case Scheme::kChase3:
+      return "chase3";
+    case Scheme::kHarqChase:
+      return "harq_chase";
+    case Scheme::kHarqIr:
+      return "harq_ir";
+  }
+  return "unknown";
+}
+
+double SimulationPoint::ber() const {
+  return bits == 0 ? 0.0 : static_cast<double>(bit_errors) / bits;
+}
+
+double SimulationPoint::fer() const {
+  return frames == 0 ? 0.0 : static_cast<double>(frame_errors) / frames;
+}
+
+double SimulationPoint::throughput() const {
+  if (channel_symbols == 0 || frames == 0) {
+    return 0.0;
+  }
+  const double delivered =
+      static_cast<double>(frames - frame_errors) * bits / frames;
+  return delivered / static_cast<double>(channel_symbols);
+}
+
+Simulator::Simulator(SimulationConfig config)
+    : config_(std::move(config)), threads_(config_.threads) {
+  if (config_.threads < 0) {
+    throw std::invalid_argument("Thread count must be non-negative.");
+  }
+  if (config_.batch_frames <= 0) {
+    throw std::invalid_argument("Batch size must be positive.");
+  }
+  if (config_.target_relative_ci < 0.0) {
+    throw std::invalid_argument("Confidence target must be non-negative.");
+  }
+  if (threads_ == 0) {
+    threads_ = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+const SimulationConfig& Simulator::config() const { return config_; }
+
+std::vector<SimulationPoint> Simulator::Run() const {
+  std::vector<SimulationPoint> points;
+  points.reserve(config_.schemes.size() * config_.snr_db.size());
+  for (Scheme scheme : config_.schemes) {
+    for (double snr_db : config_.snr_db) {
+      points.push_back(RunPoint(scheme, snr_db));
+    }
+  }
+  return points;
+}
+
+SimulationPoint Simulator::RunPoint(Scheme scheme, double snr_db) const {
+  // Канал и рабочие пространства создаются до запуска потоков, чтобы
+  // ошибки параметров выбрасывались в вызывающем потоке.
+  const AwgnChannel base(snr_db, config_.seed);
+  std::vector<FrameWorker> workers;
+  workers.reserve(threads_);
+  for (int t = 0; t < threads_; t++) {
+    workers.emplace_back(config_, scheme);
+  }
+
+  PointState state;
+  if (threads_ == 1) {
+    RunWorker(config_, base, workers[0], state);
+  } else {
+    std::vector<std::thread> pool;
+    pool.reserve(threads_);
+    for (int t = 0; t < threads_; t++) {
+      pool.emplace_back(RunWorker, std::cref(config_), std::cref(base),
+                        std::ref(workers[t]), std::ref(state));
+    }
+    for (std::thread& thread : pool) {
+      thread.join();
+    }
+  }
+
+  SimulationPoint point;
+  point.scheme = scheme;
+  point.snr_db = snr_db;
+  point.frames = state.frames.load();
+  point.frame_errors = state.frame_errors.load();
+  point.bits = point.frames * static_cast<uint64_t>(workers[0].k());
+  point.bit_errors = state.bit_errors.load();
+  point.channel_symbols = state.channel_symbols.load();
+  return point;
+}
+
+void WriteCurves(std::ostream& out,
+                 const std::vector<SimulationPoint>& points) {
+  out << "scheme,snr_db,frames,frame_errors,fer,bits,bit_errors,ber,"
+         "throughput\n";
+  for (const SimulationPoint& point : points) {
+    out << SchemeName(point.scheme) << ',' << point.snr_db << ','
+        << point.frames << ',' << point.frame_errors << ',' << point.fer()
+        << ',' << point.bits << ',' << point.bit_errors << ',' << point.ber()
+        << ',' << point.throughput() << '\n';
+  }
+}
+
+}  // namespace harq
@@ -0,0 +1,434 @@
+#include "soft_metric.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "simd_dispatch.hpp"
+
+namespace harq {
+
+namespace {
+
+template <typename T, typename Acc>
+Acc ScoreRowScalar(const T* llr, const uint8_t* candidate, std::size_t n,
+                   std::size_t start) {
+  Acc metric = 0;
+  for (std::size_t i = start; i < n; i++) {
+    const uint8_t hard = llr[i] >= 0 ? 1 : 0;
+    const Acc reliability = static_cast<Acc>(std::abs(llr[i]));
+    metric += (hard ^ candidate[i]) != 0 ? reliability : Acc{0};
+  }
+  return metric;
+}
+
+#if defined(HARQ_X86_SIMD)
+
+__attribute__((target("avx2"))) double ScoreRowAvx2(const double* llr,
+                                                    const uint8_t* candidate,
+                                                    std::size_t n) {
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  __m256d acc = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d value = _mm256_loadu_pd(llr + i);
+    int32_t packed;
+    std::memcpy(&packed, candidate + i, sizeof(packed));
+    const __m256i bits = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+    const __m256d ones = _mm256_castsi256_pd(
+        _mm256_sub_epi64(_mm256_setzero_si256(), bits));
+    const __m256d hard = _mm256_cmp_pd(value, zero, _CMP_GE_OQ);
+    const __m256d disagree = _mm256_xor_pd(hard, ones);
+    acc = _mm256_add_pd(acc, _mm256_and_pd(_mm256_andnot_pd(sign, value),
+                                           disagree));
+  }
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         ScoreRowScalar<double, double>(llr, candidate, n, i);
+}
+
+__attribute__((target("avx2"))) float ScoreRowAvx2(const float* llr,
+                                                   const uint8_t* candidate,
+                                                   std::size_t n) {
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  __m256 acc = _mm256_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 value = _mm256_loadu_ps(llr + i);
+    const __m256i bits = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(candidate + i)));
+    const __m256 ones = _mm256_castsi256_ps(
+        _mm256_sub_epi32(_mm256_setzero_si256(), bits));
+    const __m256 hard = _mm256_cmp_ps(value, zero, _CMP_GE_OQ);
+    const __m256 disagree = _mm256_xor_ps(hard, ones);
+    acc = _mm256_add_ps(acc, _mm256_and_ps(_mm256_andnot_ps(sign, value),
+                                           disagree));
+  }
+  alignas(32) float lanes[8];
+  _mm256_store_ps(lanes, acc);
+  float metric = 0.0f;
+  for (float lane : lanes) {
+    metric += lane;
+  }
+  return metric + ScoreRowScalar<float, float>(llr, candidate, n, i);
+}
+
+__attribute__((target("avx2"))) int32_t ScoreRowAvx2(const int16_t* llr,
+                                                     const uint8_t* candidate,
+                                                     std::size_t n) {
+  const __m256i minus_one = _mm256_set1_epi16(-1);
+  const __m256i ones16 = _mm256_set1_epi16(1);
+  __m256i acc = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256i value =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(llr + i));
+    const __m256i bits = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(candidate + i)));
+    const __m256i ones = _mm256_sub_epi16(_mm256_setzero_si256(), bits);
+    const __m256i hard = _mm256_cmpgt_epi16(value, minus_one);
+    const __m256i disagree = _mm256_xor_si256(hard, ones);
+    const __m256i masked =
+        _mm256_and_si256(_mm256_abs_epi16(value), disagree);
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(masked, ones16));
+  }
+  alignas(32) int32_t lanes[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+  int32_t metric = 0;
+  for (int32_t lane : lanes) {
+    metric += lane;
+  }
+  return metric + ScoreRowScalar<int16_t, int32_t>(llr, candidate, n, i);
+}
+
+__attribute__((target("avx2"))) int32_t ScoreRowAvx2(const int8_t* llr,
+                                                     const uint8_t* candidate,
+                                                     std::size_t n) {
+  const __m256i minus_one = _mm256_set1_epi8(-1);
+  const __m256i ones8 = _mm256_set1_epi8(1);
+  const __m256i ones16 = _mm256_set1_epi16(1);
+  __m256i acc = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i value =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(llr + i));
+    const __m256i bits =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(candidate + i));
+    const __m256i ones = _mm256_sub_epi8(_mm256_setzero_si256(), bits);
+    const __m256i hard = _mm256_cmpgt_epi8(value, minus_one);
+    const __m256i disagree = _mm256_xor_si256(hard, ones);
+    // |-128| = 128 не помещается в int8_t, но maddubs читает его без знака.
+    const __m256i masked =
+        _mm256_and_si256(_mm256_abs_epi8(value), disagree);
+    acc = _mm256_add_epi32(
+        acc, _mm256_madd_epi16(_mm256_maddubs_epi16(masked, ones8), ones16));
+  }
+  alignas(32) int32_t lanes[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+  int32_t metric = 0;
+  for (int32_t lane : lanes) {
+    metric += lane;
+  }
+  return metric + ScoreRowScalar<int8_t, int32_t>(llr, candidate, n, i);
+}
+
+__attribute__((target("sse4.1"))) double ScoreRowSse41(
+    const double* llr, const uint8_t* candidate, std::size_t n) {
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d sign = _mm_set1_pd(-0.0);
+  __m128d acc = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d value = _mm_loadu_pd(llr + i);
+    int16_t packed;
+    std::memcpy(&packed, candidate + i, sizeof(packed));
+    const __m128i bits = _mm_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+    const __m128d ones =
+        _mm_castsi128_pd(_mm_sub_epi64(_mm_setzero_si128(), bits));
+    const __m128d disagree = _mm_xor_pd(_mm_cmpge_pd(value, zero), ones);
+    acc = _mm_add_pd(acc, _mm_and_pd(_mm_andnot_pd(sign, value), disagree));
+  }
+  alignas(16) double lanes[2];
+  _mm_store_pd(lanes, acc);
+  return lanes[0] + lanes[1] +
+         ScoreRowScalar<double, double>(llr, candidate, n, i);
+}
+
+__attribute__((target("sse4.1"))) float ScoreRowSse41(
+    const float* llr, const uint8_t* candidate, std::size_t n) {
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  __m128 acc = _mm_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 value = _mm_loadu_ps(llr + i);
+    int32_t packed;
+    std::memcpy(&packed, candidate + i, sizeof(packed));
+    const __m128i bits = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+    const __m128 ones =
+        _mm_castsi128_ps(_mm_sub_epi32(_mm_setzero_si128(), bits));
+    const __m128 disagree = _mm_xor_ps(_mm_cmpge_ps(value, zero), ones);
+    acc = _mm_add_ps(acc, _mm_and_ps(_mm_andnot_ps(sign, value), disagree));
+  }
+  alignas(16) float lanes[4];
+  _mm_store_ps(lanes, acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         ScoreRowScalar<float, float>(llr, candidate, n, i);
+}
+
+__attribute__((target("sse4.1"))) int32_t ScoreRowSse41(
+    const int16_t* llr, const uint8_t* candidate, std::size_t n) {
+  const __m128i minus_one = _mm_set1_epi16(-1);
+  const __m128i ones16 = _mm_set1_epi16(1);
+  __m128i acc = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m128i value =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(llr + i));
+    const __m128i bits = _mm_cvtepu8_epi16(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(candidate + i)));
+    const __m128i ones = _mm_sub_epi16(_mm_setzero_si128(), bits);
+    const __m128i disagree =
+        _mm_xor_si128(_mm_cmpgt_epi16(value, minus_one), ones);
+    const __m128i masked = _mm_and_si128(_mm_abs_epi16(value), disagree);
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(masked, ones16));
+  }
+  alignas(16) int32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         ScoreRowScalar<int16_t, int32_t>(llr, candidate, n, i);
+}
+
+__attribute__((target("avx2"))) std::size_t AccumulateAvx2(double* acc,
+                                                            const double* llr,
+                                                            std::size_t n,
+                                                            double scale) {
+  const __m256d factor = _mm256_set1_pd(scale);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d sum = _mm256_add_pd(
+        _mm256_loadu_pd(acc + i),
+        _mm256_mul_pd(factor, _mm256_loadu_pd(llr + i)));
+    _mm256_storeu_pd(acc + i, sum);
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t AccumulateAvx2(float* acc,
+                                                            const float* llr,
+                                                            std::size_t n,
+                                                            float scale) {
+  const __m256 factor = _mm256_set1_ps(scale);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 sum = _mm256_add_ps(
+        _mm256_loadu_ps(acc + i),
+        _mm256_mul_ps(factor, _mm256_loadu_ps(llr + i)));
+    _mm256_storeu_ps(acc + i, sum);
+  }
+  return i;
+}
+
+__attribute__((target("sse4.1"))) int32_t ScoreRowSse41(
+    const int8_t* llr, const uint8_t* candidate, std::size_t n) {
+  const __m128i minus_one = _mm_set1_epi8(-1);
+  const __m128i ones8 = _mm_set1_epi8(1);
+  const __m128i ones16 = _mm_set1_epi16(1);
+  __m128i acc = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i value =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(llr + i));
+    const __m128i bits =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(candidate + i));
+    const __m128i ones = _mm_sub_epi8(_mm_setzero_si128(), bits);
+    const __m128i disagree =
+        _mm_xor_si128(_mm_cmpgt_epi8(value, minus_one), ones);
+    const __m128i masked = _mm_and_si128(_mm_abs_epi8(value), disagree);
+    acc = _mm_add_epi32(
+        acc, _mm_madd_epi16(_mm_maddubs_epi16(masked, ones8), ones16));
+  }
+  alignas(16) int32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         ScoreRowScalar<int8_t, int32_t>(llr, candidate, n, i);
+}
+
+__attribute__((target("avx2"))) std::size_t AccumulateSaturatedAvx2(
+    int8_t* acc, const int8_t* llr, std::size_t n, int limit) {
+  const __m256i high = _mm256_set1_epi8(static_cast<int8_t>(limit));
+  const __m256i low = _mm256_set1_epi8(static_cast<int8_t>(-limit));
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i sum = _mm256_adds_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + i)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(llr + i)));
+    sum = _mm256_max_epi8(_mm256_min_epi8(sum, high), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i), sum);
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t AccumulateSaturatedAvx2(
+    int16_t* acc, const int16_t* llr, std::size_t n, int limit) {
+  const __m256i high = _mm256_set1_epi16(static_cast<int16_t>(limit));
+  const __m256i low = _mm256_set1_epi16(static_cast<int16_t>(-limit));
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i sum = _mm256_adds_epi16(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + i)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(llr + i)));
+    sum = _mm256_max_epi16(_mm256_min_epi16(sum, high), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i), sum);
+  }
+  return i;
+}
+
+#endif  // HARQ_X86_SIMD
+
+template <typename T>
+void AccumulateSaturatedAll(std::span<T> acc, std::span<const T> llr,
+                            int limit, SimdLevel level) {
+  if (acc.size() != llr.size()) {
+    throw std::invalid_argument("Soft buffer and LLR sizes must match.");
+  }
+  if (limit <= 0 || limit > std::numeric_limits<T>::max()) {
+    throw std::invalid_argument("Saturation limit is out of range.");
+  }
+  std::size_t i = 0;
+#if defined(HARQ_X86_SIMD)
+  if (UseAvx2(level)) {
+    i = AccumulateSaturatedAvx2(acc.data(), llr.data(), acc.size(), limit);
+  }
+#else
+  (void)level;
+#endif
+  for (; i < acc.size(); i++) {
+    const int sum = acc[i] + llr[i];
+    acc[i] = static_cast<T>(std::clamp(sum, -limit, limit));
+  }
+}
+
+template <typename T>
+void AccumulateAll(std::span<T> acc, std::span<const T> llr, T scale,
+                   SimdLevel level) {
+  if (acc.size() != llr.size()) {
+    throw std::invalid_argument("Soft buffer and LLR sizes must match.");
+  }
+  std::size_t i = 0;
+#if defined(HARQ_X86_SIMD)
+  if (UseAvx2(level)) {
+    i = AccumulateAvx2(acc.data(), llr.data(), acc.size(), scale);
+  }
+#else
+  (void)level;
+#endif
+  // Хвост и скалярный путь; без AVX2 цикл векторизуется компилятором (SSE2).
+  for (; i < acc.size(); i++) {
+    acc[i] += scale * llr[i];
+  }
+}
+
+template <typename T, typename Acc>
+void ScoreAll(std::span<const T> llr, std::span<const uint8_t> candidates,
+              std::span<Acc> metrics, SimdLevel level) {
+  const std::size_t n = llr.size();
+  if (candidates.size() != n * metrics.size()) {
+    throw std::invalid_argument(
+        "Candidate buffer must hold metrics.size() rows of llr.size() bits.");
+  }
+  // Уровень выше поддерживаемого процессором понижается.
+  if (level > DetectSimdLevel()) {
+    level = DetectSimdLevel();
+  }
+
+  for (std::size_t row = 0; row < metrics.size(); row++) {
+    const uint8_t* candidate = candidates.data() + row * n;
+    switch (level) {
+#if defined(HARQ_X86_SIMD)
+      case SimdLevel::kAvx2:
+        metrics[row] = ScoreRowAvx2(llr.data(), candidate, n);
+        break;
+      case SimdLevel::kSse41:
+        metrics[row] = ScoreRowSse41(llr.data(), candidate, n);
+        break;
+#endif
+      default:
+        metrics[row] = ScoreRowScalar<T, Acc>(llr.data(), candidate, n, 0);
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+SimdLevel DetectSimdLevel() {
+#if defined(HARQ_X86_SIMD)
+  static const SimdLevel level = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return SimdLevel::kAvx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+      return SimdLevel::kSse41;
+    }
+    return SimdLevel::kScalar;
+  }();
+  return level;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+void ScoreCandidates(std::span<const double> llr,
+                     std::span<const uint8_t> candidates,
+                     std::span<double> metrics, SimdLevel level) {
+  ScoreAll<double, double>(llr, candidates, metrics, level);
+}
+
+void ScoreCandidates(std::span<const float> llr,
+                     std::span<const uint8_t> candidates,
+                     std::span<float> metrics, SimdLevel level) {
+  ScoreAll<float, float>(llr, candidates, metrics, level);
+}
+
+void ScoreCandidates(std::span<const int16_t> llr,
+                     std::span<const uint8_t> candidates,
+                     std::span<int32_t> metrics, SimdLevel level) {
+  ScoreAll<int16_t, int32_t>(llr, candidates, metrics, level);
+}
+
+void ScoreCandidates(std::span<const int8_t> llr,
+                     std::span<const uint8_t> candidates,
+                     std::span<int32_t> metrics, SimdLevel level) {
+  ScoreAll<int8_t, int32_t>(llr, candidates, metrics, level);
+}
+
+void AccumulateLlr(std::span<double> acc, std::span<const double> llr,
+                   double scale, SimdLevel level) {
+  AccumulateAll<double>(acc, llr, scale, level);
+}
+
+void AccumulateLlr(std::span<float> acc, std::span<const float> llr,
+                   float scale, SimdLevel level) {
+  AccumulateAll<float>(acc, llr, scale, level);
+}
+
+void AccumulateLlrSaturated(std::span<int8_t> acc, std::span<const int8_t> llr,
+                            int limit, SimdLevel level) {
+  AccumulateSaturatedAll<int8_t>(acc, llr, limit, level);
+}
+
+void AccumulateLlrSaturated(std::span<int16_t> acc,
+                            std::span<const int16_t> llr, int limit,
+                            SimdLevel level) {
+  AccumulateSaturatedAll<int16_t>(acc, llr, limit, level);
+}
+
+}  // namespace harq
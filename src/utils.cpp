@@ -1,8 +1,120 @@
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
+#include <type_traits>
+#include "simd_dispatch.hpp"
 #include "utils.hpp"
 
 namespace harq {
+
+namespace {
+
+// Регистр t наименьших значений: keys по возрастанию, ids — их индексы.
+template <typename Key>
+struct SmallestRegister {
+  Key keys[kMaxLeastReliable];
+  std::size_t* ids;
+  std::size_t size;
+
+  // Вставка сравнением-обменом: новый элемент проходит по регистру, на
+  // каждой позиции меньший остаётся, больший переносится дальше, последний
+  // выпадает. Пара (значение, индекс) сохраняет порядок равных значений.
+  void Insert(Key value, std::size_t index) {
+    for (std::size_t j = 0; j < size; j++) {
+      const bool less =
+          value < keys[j] || (value == keys[j] && index < ids[j]);
+      const Key key = keys[j];
+      const std::size_t id = ids[j];
+      keys[j] = less ? value : key;
+      ids[j] = less ? index : id;
+      value = less ? key : value;
+      index = less ? id : index;
+    }
+  }
+
+  Key threshold() const { return keys[size - 1]; }
+
+  bool Accepts(Key value, std::size_t index) const {
+    return value < keys[size - 1] ||
+           (value == keys[size - 1] && index < ids[size - 1]);
+  }
+};
+
+template <typename T>
+using KeyType = std::conditional_t<std::is_floating_point_v<T>, T, int>;
+
+// Начальный порог: ни одно значение не может быть больше.
+template <typename Key>
+constexpr Key MaxKey() {
+  if constexpr (std::is_floating_point_v<Key>) {
+    return std::numeric_limits<Key>::infinity();
+  } else {
+    return std::numeric_limits<Key>::max();
+  }
+}
+
+#if defined(HARQ_X86_SIMD)
+
+// Проходит блоками по 4 значения и отдаёт в регистр только блоки, где
+// хотя бы одно |value| меньше порога. Возвращает число обработанных.
+__attribute__((target("avx2"))) std::size_t FilterAvx2(
+    const double* values, std::size_t n, SmallestRegister<double>& reg) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d magnitude =
+        _mm256_andnot_pd(sign, _mm256_loadu_pd(values + i));
+    int mask = _mm256_movemask_pd(_mm256_cmp_pd(
+        magnitude, _mm256_set1_pd(reg.threshold()), _CMP_LE_OQ));
+    while (mask != 0) {
+      const int lane = __builtin_ctz(mask);
+      mask &= mask - 1;
+      const double value = std::abs(values[i + lane]);
+      if (reg.Accepts(value, i + lane)) {
+        reg.Insert(value, i + lane);
+      }
+    }
+  }
+  return i;
+}
+
+#endif  // HARQ_X86_SIMD
+
+template <typename T>
+void SelectSmallest(std::span<const T> values, std::span<std::size_t> out) {
+  using Key = KeyType<T>;
+  if (out.empty() || out.size() > values.size()) {
+    throw std::invalid_argument("Reliability values are incorrect.");
+  }
+  if (out.size() > kMaxLeastReliable) {
+    throw std::invalid_argument("Too many least reliable positions.");
+  }
+
+  SmallestRegister<Key> reg;
+  reg.ids = out.data();
+  reg.size = out.size();
+  std::fill_n(reg.keys, reg.size, MaxKey<Key>());
+  std::fill(out.begin(), out.end(), values.size());
+
+  std::size_t i = 0;
+#if defined(HARQ_X86_SIMD)
+  if constexpr (std::is_same_v<T, double>) {
+    if (DetectSimdLevel() == SimdLevel::kAvx2) {
+      i = FilterAvx2(values.data(), values.size(), reg);
+    }
+  }
+#endif
+  for (; i < values.size(); i++) {
+    const Key value = std::abs(static_cast<Key>(values[i]));
+    if (reg.Accepts(value, i)) {
+      reg.Insert(value, i);
+    }
+  }
+}
+
+}  // namespace
+
 std::vector<size_t> get_n_smallest_indices(const std::vector<double> &soft_desicions,
                                            int n) {
   std::vector<size_t> result;
@@ -11,16 +123,20 @@ std::vector<size_t> get_n_smallest_indices(const std::vector<double> &soft_desic
     throw std::invalid_argument("Reliability values are incorrect.");
   }
 
+  if (static_cast<size_t>(n) <= kMaxLeastReliable) {
+    result.resize(n);
+    SelectLeastReliable(soft_desicions, result);
+    return result;
+  }
+
   std::vector<std::pair<double, size_t>> indexed;
   indexed.reserve(soft_desicions.size());
 
   for (size_t i = 0; i < soft_desicions.size(); i++) {
-    indexed.emplace_back(soft_desicions[i], i);
+    indexed.emplace_back(std::abs(soft_desicions[i]), i);
   }
 
-  std::partial_sort(
-      indexed.begin(), indexed.begin() + n, indexed.end(),
-      [](const auto &a, const auto &b) { return std::abs(a.first) < std::abs(b.first); });
+  std::partial_sort(indexed.begin(), indexed.begin() + n, indexed.end());
 
   result.reserve(n);
   for (int i = 0; i < n; i++) {
@@ -30,4 +146,19 @@ std::vector<size_t> get_n_smallest_indices(const std::vector<double> &soft_desic
   return result;
 }
 
+void SelectLeastReliable(std::span<const double> values,
+                         std::span<std::size_t> out) {
+  SelectSmallest(values, out);
+}
+
+void SelectLeastReliable(std::span<const int8_t> values,
+                         std::span<std::size_t> out) {
+  SelectSmallest(values, out);
+}
+
+void SelectLeastReliable(std::span<const int16_t> values,
+                         std::span<std::size_t> out) {
+  SelectSmallest(values, out);
+}
+
 } // namespace harq
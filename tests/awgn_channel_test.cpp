@@ -0,0 +1,180 @@
+#include "awgn_channel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+TEST(AwgnChannelTest, ConsecutiveFramesGetDifferentNoise) {
+  harq::AwgnChannel channel(3.0);
+  const std::vector<double> symbols(64, 1.0);
+
+  const std::vector<double> first = channel.AddNoise(symbols);
+  const std::vector<double> second = channel.AddNoise(symbols);
+
+  EXPECT_NE(first, second);
+}
+
+TEST(AwgnChannelTest, SameSeedReproducesSequence) {
+  harq::AwgnChannel a(2.0, 17);
+  harq::AwgnChannel b(2.0, 17);
+  const std::vector<double> symbols(32, -1.0);
+
+  for (int frame = 0; frame < 3; frame++) {
+    EXPECT_EQ(a.AddNoise(symbols), b.AddNoise(symbols));
+  }
+}
+
+TEST(AwgnChannelTest, ForkedStreamsAreIndependentAndReproducible) {
+  harq::AwgnChannel channel(1.0, 5);
+  harq::AwgnChannel worker0 = channel.Fork(0);
+  harq::AwgnChannel worker1 = channel.Fork(1);
+  harq::AwgnChannel worker1_again = channel.Fork(1);
+
+  const std::vector<double> symbols(128, 1.0);
+  const std::vector<double> noisy1 = worker1.AddNoise(symbols);
+
+  EXPECT_NE(worker0.AddNoise(symbols), noisy1);
+  EXPECT_EQ(worker1_again.AddNoise(symbols), noisy1);
+  EXPECT_DOUBLE_EQ(worker1.snr_db(), 1.0);
+}
+
+TEST(AwgnChannelTest, ForkDiffersFromParentAndFollowsJumps) {
+  harq::AwgnChannel parent(1.0, 5);
+  const harq::AwgnChannel fresh(1.0, 5);
+  harq::AwgnChannel child = parent.Fork(0);
+  harq::AwgnChannel grandchild = child.Fork(0);
+
+  const std::vector<double> symbols(64, 0.0);
+  const std::vector<double> from_child = child.AddNoise(symbols);
+  EXPECT_NE(parent.AddNoise(symbols), from_child);
+  EXPECT_NE(grandchild.AddNoise(symbols), from_child);
+  EXPECT_NE(fresh.Fork(1).Fork(0).AddNoise(symbols),
+            fresh.Fork(0).Fork(1).AddNoise(symbols));
+
+  harq::AwgnChannel jumped(1.0, 5);
+  jumped.Jump();
+  harq::AwgnChannel expected = fresh.Fork(0);
+  expected.Jump();
+  EXPECT_EQ(jumped.Fork(0).AddNoise(symbols), expected.AddNoise(symbols));
+  EXPECT_NE(jumped.Fork(0).AddNoise(symbols), fresh.Fork(0).AddNoise(symbols));
+}
+
+TEST(AwgnChannelTest, JumpMovesToAnotherSubsequence) {
+  harq::AwgnChannel a(0.0, 9);
+  harq::AwgnChannel b(0.0, 9);
+  b.Jump();
+
+  const std::vector<double> symbols(16, 0.0);
+  EXPECT_NE(a.AddNoise(symbols), b.AddNoise(symbols));
+}
+
+TEST(AwgnChannelTest, NoiseVarianceFollowsSnr) {
+  harq::AwgnChannel channel(6.0);
+  std::vector<double> samples(1 << 18, 0.0);
+  channel.AddNoiseInPlace(samples);
+
+  double power = 0.0;
+  for (double x : samples) {
+    power += x * x;
+  }
+  power /= static_cast<double>(samples.size());
+
+  EXPECT_NEAR(channel.noise_variance(), std::pow(10.0, -0.6), 1e-12);
+  EXPECT_NEAR(power, channel.noise_variance(), 0.01);
+}
+
+TEST(AwgnChannelTest, ComputesScaledLlr) {
+  harq::AwgnChannel channel(0.0);
+  const std::vector<double> llr = channel.ComputeLlr({0.5, -1.0});
+  EXPECT_DOUBLE_EQ(llr[0], 1.0);
+  EXPECT_DOUBLE_EQ(llr[1], -2.0);
+
+  EXPECT_THROW(harq::AwgnChannel(std::nan("")), std::invalid_argument);
+}
+
+TEST(PassbandAwgnChannelTest, NoiseVarianceFollowsEbN0AndCarrier) {
+  harq::BpskCarrierConfig config;
+  config.carrier_hz = 3.0;
+  config.sample_rate_hz = 16.0;
+  config.samples_per_symbol = 8;
+  config.amplitude = 2.0;
+
+  // Eb = A^2 * sps / 2 = 16, sigma^2 = Eb / (2 * 10^(6/10)).
+  harq::PassbandAwgnChannel channel(6.0, config, 3);
+  EXPECT_NEAR(channel.bit_energy(), 16.0, 1e-12);
+  const double expected = 16.0 / (2.0 * std::pow(10.0, 0.6));
+  EXPECT_NEAR(channel.noise_variance(), expected, 1e-12);
+
+  std::vector<double> samples(1 << 18, 0.0);
+  channel.AddNoiseInPlace(samples);
+  double power = 0.0;
+  for (double x : samples) {
+    power += x * x;
+  }
+  EXPECT_NEAR(power / samples.size(), expected, 0.02 * expected);
+
+  channel.SetEbN0Db(9.0);
+  EXPECT_NEAR(channel.noise_variance(), 16.0 / (2.0 * std::pow(10.0, 0.9)),
+              1e-12);
+}
+
+TEST(PassbandAwgnChannelTest, SoftDemodulatorSeesChannelVariance) {
+  harq::BpskCarrierConfig config;
+  config.carrier_hz = 5.0;
+  config.sample_rate_hz = 32.0;
+  config.samples_per_symbol = 16;
+  config.amplitude = 0.7;
+
+  std::vector<uint8_t> bits(4096);
+  for (std::size_t i = 0; i < bits.size(); i++) {
+    bits[i] = static_cast<uint8_t>((i * 7 + i / 3) & 1);
+  }
+  auto samples = harq::BpskPassbandModulate(bits, config);
+  harq::PassbandAwgnChannel channel(8.0, config, 21);
+  channel.AddNoiseInPlace(samples);
+
+  harq::BpskPassbandSoftDemodulator demodulator(config);
+  std::vector<double> llr(bits.size());
+  ASSERT_EQ(demodulator.Process(samples, llr), bits.size());
+  EXPECT_NEAR(demodulator.noise_variance(), channel.noise_variance(),
+              0.05 * channel.noise_variance());
+}
+
+TEST(PassbandAwgnChannelTest, BlocksContinueOneNoiseStream) {
+  harq::BpskCarrierConfig config;
+  config.carrier_hz = 1.0;
+  config.sample_rate_hz = 8.0;
+  config.samples_per_symbol = 4;
+
+  harq::PassbandAwgnChannel whole(4.0, config, 11);
+  harq::PassbandAwgnChannel blocks(4.0, config, 11);
+  std::vector<double> expected(1000, 0.5);
+  whole.AddNoiseInPlace(expected);
+
+  std::vector<double> samples(1000, 0.5);
+  blocks.AddNoiseInPlace(std::span<double>(samples).first(333));
+  blocks.AddNoiseInPlace(std::span<double>(samples).subspan(333));
+  EXPECT_EQ(samples, expected);
+
+  harq::PassbandAwgnChannel other = harq::PassbandAwgnChannel(
+      4.0, config, 11).Fork(0);
+  std::vector<double> independent(1000, 0.5);
+  other.AddNoiseInPlace(independent);
+  EXPECT_NE(independent, expected);
+}
+
+TEST(PassbandAwgnChannelTest, RejectsCarrierWithoutEnergy) {
+  harq::BpskCarrierConfig config;
+  config.amplitude = 0.0;
+  EXPECT_THROW(harq::PassbandAwgnChannel(3.0, config), std::invalid_argument);
+  config.amplitude = 1.0;
+  config.samples_per_symbol = 0;
+  EXPECT_THROW(harq::PassbandAwgnChannel(3.0, config), std::invalid_argument);
+  config.samples_per_symbol = 4;
+  config.carrier_hz = -0.25;
+  EXPECT_THROW(harq::PassbandAwgnChannel(3.0, config), std::invalid_argument);
+}
@@ -0,0 +1,155 @@
+#include "bit_vector.hpp"
+
+#include "bpsk.hpp"
+#include "chase_algorithm.hpp"
+#include "hamming_decoder.hpp"
+#include "hamming_encoder.hpp"
+
+#include "test_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using harq::test::RandomBits;
+
+TEST(BitVectorTest, RoundTripsThroughBytes) {
+  std::mt19937 rng(3);
+  for (std::size_t size : {0u, 1u, 63u, 64u, 65u, 128u, 129u, 300u}) {
+    const auto bits = RandomBits(rng, size);
+    const harq::BitVector vector(bits);
+    EXPECT_EQ(vector.size(), size);
+    EXPECT_EQ(vector.word_count(), (size + 63) / 64);
+    EXPECT_EQ(vector.ToBytes(), bits);
+    for (std::size_t i = 0; i < size; i++) {
+      EXPECT_EQ(vector[i], bits[i]);
+    }
+  }
+}
+
+TEST(BitVectorTest, RejectsNonBinaryBytes) {
+  EXPECT_THROW(harq::BitVector(std::vector<uint8_t>{0, 2}),
+               std::invalid_argument);
+}
+
+TEST(BitVectorTest, CopyAndMoveKeepContents) {
+  std::mt19937 rng(5);
+  for (std::size_t size : {7u, 200u}) {
+    const auto bits = RandomBits(rng, size);
+    harq::BitVector source(bits);
+
+    harq::BitVector copy = source;
+    copy.Flip(0);
+    EXPECT_EQ(source.ToBytes(), bits);
+    EXPECT_NE(copy, source);
+
+    harq::BitVector moved = std::move(source);
+    EXPECT_EQ(moved.ToBytes(), bits);
+    EXPECT_TRUE(source.empty());
+
+    copy = moved;
+    EXPECT_EQ(copy, moved);
+  }
+}
+
+TEST(BitVectorTest, ResizeAndPushBackKeepTailClear) {
+  harq::BitVector vector;
+  std::vector<uint8_t> expected;
+  for (int i = 0; i < 150; i++) {
+    vector.PushBack(i % 3 == 0);
+    expected.push_back(i % 3 == 0);
+  }
+  EXPECT_EQ(vector.ToBytes(), expected);
+
+  vector.Resize(70);
+  vector.Resize(150);
+  expected.resize(70);
+  expected.resize(150, 0);
+  EXPECT_EQ(vector.ToBytes(), expected);
+  EXPECT_EQ(vector.words()[2] >> (150 - 128), 0u);
+}
+
+TEST(BitVectorTest, XorAndPopcountWorkPerWord) {
+  std::mt19937 rng(7);
+  const auto a = RandomBits(rng, 130);
+  const auto b = RandomBits(rng, 130);
+  std::vector<uint8_t> expected(130);
+  std::size_t ones = 0;
+  for (std::size_t i = 0; i < a.size(); i++) {
+    expected[i] = a[i] ^ b[i];
+    ones += expected[i];
+  }
+
+  const harq::BitVector sum = harq::BitVector(a) ^ harq::BitVector(b);
+  EXPECT_EQ(sum.ToBytes(), expected);
+  EXPECT_EQ(sum.Popcount(), ones);
+  EXPECT_THROW(harq::BitVector(3) ^ harq::BitVector(4),
+               std::invalid_argument);
+}
+
+TEST(BitVectorTest, GatherAndScatterFollowPositions) {
+  const harq::BitVector source(std::vector<uint8_t>{1, 0, 0, 1, 1, 0, 1});
+  const std::vector<int> positions = {6, 0, 2, 3};
+
+  const harq::BitVector gathered = source.Gather(positions);
+  EXPECT_EQ(gathered.ToBytes(), (std::vector<uint8_t>{1, 1, 0, 1}));
+
+  harq::BitVector target(7);
+  target.Scatter(positions, gathered);
+  EXPECT_EQ(target.ToBytes(),
+            (std::vector<uint8_t>{1, 0, 0, 1, 0, 0, 1}));
+  EXPECT_THROW(target.Scatter(positions, harq::BitVector(2)),
+               std::invalid_argument);
+}
+
+TEST(BitVectorTest, CodecOverloadsMatchByteApi) {
+  std::mt19937 rng(11);
+  for (int r : {3, 6, 7, 8}) {
+    const harq::HammingEncoder encoder(r);
+    const harq::HammingDecoder decoder(r);
+    for (int trial = 0; trial < 20; trial++) {
+      const auto data = RandomBits(rng, encoder.k());
+      const harq::BitVector packed(data);
+
+      EXPECT_EQ(encoder.Encode(packed).ToBytes(), encoder.Encode(data));
+      auto codeword = encoder.EncodeExtended(data);
+      EXPECT_EQ(encoder.EncodeExtended(packed).ToBytes(), codeword);
+
+      codeword[rng() % codeword.size()] ^= 1;
+      const harq::BitVector received(codeword);
+      EXPECT_EQ(decoder.Correct(received).ToBytes(),
+                decoder.Correct(codeword));
+      EXPECT_EQ(decoder.Decode(received).ToBytes(), decoder.Decode(codeword));
+      EXPECT_EQ(harq::BpskModulate(received), harq::BpskModulate(codeword));
+    }
+  }
+}
+
+TEST(BitVectorTest, CandidateOverloadMatchesByteApi) {
+  std::mt19937 rng(13);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  const int n = 15;
+  for (auto algorithm : {harq::ProbeAlgorithm::First,
+                         harq::ProbeAlgorithm::Second,
+                         harq::ProbeAlgorithm::Third,
+                         harq::ProbeAlgorithm::ThirdNested}) {
+    const auto message = RandomBits(rng, n);
+    std::vector<double> reliability(n);
+    for (double& value : reliability) {
+      value = noise(rng);
+    }
+
+    const auto expected =
+        harq::CalculateCandidates(message, 4, 3, reliability, algorithm);
+    const auto packed = harq::CalculateCandidates(
+        harq::BitVector(message), 4, 3, reliability, algorithm);
+    ASSERT_EQ(packed.size(), expected.size());
+    for (std::size_t i = 0; i < packed.size(); i++) {
+      EXPECT_EQ(packed[i].ToBytes(), expected[i]);
+    }
+  }
+}
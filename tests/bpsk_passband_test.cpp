@@ -2,9 +2,18 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
+#include "carrier_oscillator.hpp"
+#include "chase_decoder.hpp"
+#include "hamming_encoder.hpp"
+
 TEST(BpskPassbandTest, ModulateAndDemodulateRoundTrip) {
   const std::vector<uint8_t> bits = {1, 0, 1, 1, 0};
 
@@ -21,3 +30,270 @@ TEST(BpskPassbandTest, ModulateAndDemodulateRoundTrip) {
 
   ASSERT_EQ(recovered, bits);
 }
+
+namespace {
+
+constexpr double kTwoPi = 6.2831853071795864769;
+
+double ReferenceCarrier(double carrier_hz, double sample_rate_hz, double phase,
+                        std::size_t index) {
+  return std::cos(kTwoPi * carrier_hz * static_cast<double>(index) /
+                      sample_rate_hz +
+                  phase);
+}
+
+}  // namespace
+
+TEST(CarrierOscillatorTest, UsesPeriodTableForRationalRatio) {
+  harq::CarrierOscillator oscillator(3000.0, 48000.0 * 1.25, 0.3);
+  ASSERT_TRUE(oscillator.tabulated());
+  EXPECT_EQ(oscillator.period(), 20u);
+
+  std::vector<double> carrier(1000);
+  oscillator.Generate(carrier);
+  for (std::size_t i = 0; i < carrier.size(); i++) {
+    EXPECT_NEAR(carrier[i], ReferenceCarrier(3000.0, 60000.0, 0.3, i), 1e-12);
+  }
+}
+
+TEST(CarrierOscillatorTest, RotatorTracksIrrationalRatio) {
+  const double carrier_hz = 1000.0 * std::sqrt(2.0);
+  harq::CarrierOscillator oscillator(carrier_hz, 8000.0, -0.7);
+  ASSERT_FALSE(oscillator.tabulated());
+
+  std::vector<double> carrier(200000);
+  oscillator.Generate(carrier);
+  for (std::size_t i = 0; i < carrier.size(); i += 997) {
+    EXPECT_NEAR(carrier[i], ReferenceCarrier(carrier_hz, 8000.0, -0.7, i),
+                1e-9);
+  }
+}
+
+TEST(CarrierOscillatorTest, PhaseIsContinuousAcrossChunks) {
+  for (double carrier_hz : {2000.0, 1234.5678 * std::sqrt(3.0)}) {
+    harq::CarrierOscillator whole(carrier_hz, 16000.0, 1.0);
+    harq::CarrierOscillator chunked(carrier_hz, 16000.0, 1.0);
+
+    std::vector<double> expected(5000);
+    whole.Generate(expected);
+    std::vector<double> actual(expected.size());
+    std::size_t offset = 0;
+    for (std::size_t chunk = 1; offset < actual.size(); chunk = chunk * 3 + 1) {
+      const std::size_t size = std::min(chunk, actual.size() - offset);
+      chunked.Generate(std::span<double>(actual).subspan(offset, size));
+      offset += size;
+    }
+    EXPECT_EQ(chunked.position(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); i++) {
+      ASSERT_DOUBLE_EQ(actual[i], expected[i]) << "sample " << i;
+    }
+
+    chunked.Reset();
+    std::vector<double> again(3);
+    chunked.Generate(again);
+    EXPECT_DOUBLE_EQ(again[2], expected[2]);
+  }
+}
+
+TEST(BpskPassbandStreamTest, ChunkedStreamMatchesBatchPath) {
+  harq::BpskCarrierConfig config;
+  config.carrier_hz = 1500.0 * std::sqrt(2.0);
+  config.sample_rate_hz = 16000.0;
+  config.samples_per_symbol = 7;
+  config.amplitude = 0.5;
+  config.phase = 0.4;
+
+  std::vector<uint8_t> bits(300);
+  for (std::size_t i = 0; i < bits.size(); i++) {
+    bits[i] = static_cast<uint8_t>((i * 7 + i / 3) % 2);
+  }
+  const std::vector<double> expected = harq::BpskPassbandModulate(bits, config);
+
+  // Модулятор: блоки битов разной длины.
+  harq::BpskPassbandStreamModulator modulator(config);
+  std::vector<double> samples(expected.size());
+  std::size_t bit = 0;
+  for (std::size_t chunk = 1; bit < bits.size(); chunk = chunk * 2 + 1) {
+    const std::size_t count = std::min(chunk, bits.size() - bit);
+    modulator.Process(
+        std::span<const uint8_t>(bits).subspan(bit, count),
+        std::span<double>(samples).subspan(bit * 7, count * 7));
+    bit += count;
+  }
+  EXPECT_EQ(modulator.position(), samples.size());
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    ASSERT_DOUBLE_EQ(samples[i], expected[i]) << "sample " << i;
+  }
+
+  // Демодулятор: блоки, не кратные samples_per_symbol.
+  harq::BpskPassbandStreamDemodulator demodulator(config);
+  std::vector<uint8_t> recovered;
+  std::vector<uint8_t> block_bits(2048);
+  std::size_t offset = 0;
+  for (std::size_t chunk = 5; offset < samples.size(); chunk += 13) {
+    const std::size_t count = std::min(chunk, samples.size() - offset);
+    const std::span<const double> block =
+        std::span<const double>(samples).subspan(offset, count);
+    const std::size_t expected_symbols = demodulator.SymbolsFor(count);
+    const std::size_t produced = demodulator.Process(block, block_bits);
+    ASSERT_EQ(produced, expected_symbols);
+    recovered.insert(recovered.end(), block_bits.begin(),
+                     block_bits.begin() + produced);
+    offset += count;
+  }
+  EXPECT_EQ(demodulator.pending_samples(), 0);
+  EXPECT_EQ(recovered, bits);
+}
+
+TEST(BpskPassbandStreamTest, RejectsMismatchedBuffers) {
+  harq::BpskCarrierConfig config;
+  config.samples_per_symbol = 4;
+  harq::BpskPassbandStreamModulator modulator(config);
+  const std::vector<uint8_t> bits = {1, 0};
+  std::vector<double> samples(7);
+  EXPECT_THROW(modulator.Process(bits, samples), std::invalid_argument);
+
+  harq::BpskPassbandStreamDemodulator demodulator(config);
+  std::vector<double> input(9, 1.0);
+  std::vector<uint8_t> out(1);
+  EXPECT_THROW(demodulator.Process(input, out), std::invalid_argument);
+  config.samples_per_symbol = 0;
+  EXPECT_THROW(harq::BpskPassbandStreamDemodulator{config},
+               std::invalid_argument);
+}
+
+namespace {
+
+harq::BpskCarrierConfig SoftTestConfig() {
+  harq::BpskCarrierConfig config;
+  config.carrier_hz = 3.0;
+  config.sample_rate_hz = 16.0;
+  config.samples_per_symbol = 16;
+  config.amplitude = 0.5;
+  return config;
+}
+
+std::vector<double> NoisySamples(const std::vector<uint8_t>& bits,
+                                 const harq::BpskCarrierConfig& config,
+                                 double noise_variance, uint32_t seed) {
+  auto samples = harq::BpskPassbandModulate(bits, config);
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(0.0, std::sqrt(noise_variance));
+  for (double& sample : samples) {
+    sample += noise(rng);
+  }
+  return samples;
+}
+
+}  // namespace
+
+TEST(BpskPassbandSoftTest, KnownVarianceGivesMatchedFilterLlr) {
+  const auto config = SoftTestConfig();
+  const std::vector<uint8_t> bits = {1, 0, 0, 1, 1, 0, 1};
+  const auto samples = harq::BpskPassbandModulate(bits, config);
+  const double variance = 0.25;
+
+  harq::BpskPassbandSoftDemodulator demodulator(config, variance);
+  EXPECT_FALSE(demodulator.estimates_noise());
+  std::vector<double> llr(bits.size());
+  ASSERT_EQ(demodulator.Process(samples, llr), bits.size());
+
+  const int sps = config.samples_per_symbol;
+  for (std::size_t symbol = 0; symbol < bits.size(); symbol++) {
+    double correlation = 0.0;
+    for (int i = 0; i < sps; i++) {
+      const std::size_t n = symbol * sps + i;
+      correlation += samples[n] * ReferenceCarrier(config.carrier_hz,
+                                                   config.sample_rate_hz,
+                                                   config.phase, n);
+    }
+    EXPECT_NEAR(llr[symbol], 2.0 * config.amplitude * correlation / variance,
+                1e-9);
+    EXPECT_EQ(llr[symbol] >= 0.0 ? 1 : 0, bits[symbol]);
+  }
+}
+
+TEST(BpskPassbandSoftTest, EstimatesNoiseVariance) {
+  const auto config = SoftTestConfig();
+  std::mt19937 rng(11);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<uint8_t> bits(4000);
+  for (auto& bit : bits) {
+    bit = coin(rng) ? 1 : 0;
+  }
+  const double variance = 0.04;
+  const auto samples = NoisySamples(bits, config, variance, 12);
+
+  harq::BpskPassbandSoftDemodulator demodulator(config);
+  EXPECT_TRUE(demodulator.estimates_noise());
+  std::vector<double> llr(bits.size());
+  ASSERT_EQ(demodulator.Process(samples, llr), bits.size());
+  EXPECT_NEAR(demodulator.noise_variance(), variance, 0.05 * variance);
+
+  // Оценённый масштаб совпадает с масштабом при известной дисперсии.
+  harq::BpskPassbandSoftDemodulator reference(config,
+                                              demodulator.noise_variance());
+  std::vector<double> expected(bits.size());
+  reference.Process(samples, expected);
+  EXPECT_NEAR(llr.back(), expected.back(), 1e-9 * std::abs(expected.back()));
+
+  demodulator.Reset();
+  EXPECT_EQ(demodulator.pending_samples(), 0);
+  EXPECT_DOUBLE_EQ(demodulator.noise_variance(), 1.0);
+}
+
+TEST(BpskPassbandSoftTest, ChunkedProcessingMatchesWholeSignal) {
+  auto config = SoftTestConfig();
+  config.carrier_hz = 2.3;
+  config.samples_per_symbol = 13;
+  const std::vector<uint8_t> bits(300, 1);
+  const auto samples = NoisySamples(bits, config, 0.1, 21);
+
+  harq::BpskPassbandSoftDemodulator whole(config, 0.1);
+  std::vector<double> expected(bits.size());
+  ASSERT_EQ(whole.Process(samples, expected), bits.size());
+
+  harq::BpskPassbandSoftDemodulator chunked(config, 0.1);
+  std::vector<double> llr(bits.size());
+  std::size_t produced = 0;
+  std::size_t offset = 0;
+  for (std::size_t chunk = 1; offset < samples.size(); chunk = chunk * 3 + 1) {
+    const std::size_t count = std::min(chunk, samples.size() - offset);
+    produced += chunked.Process(
+        std::span<const double>(samples).subspan(offset, count),
+        std::span<double>(llr).subspan(produced));
+    offset += count;
+  }
+  ASSERT_EQ(produced, bits.size());
+  for (std::size_t i = 0; i < bits.size(); i++) {
+    EXPECT_NEAR(llr[i], expected[i], 1e-9 * std::abs(expected[i]));
+  }
+
+  std::vector<double> small(1);
+  EXPECT_THROW(chunked.Process(samples, small), std::invalid_argument);
+  EXPECT_THROW(harq::BpskPassbandSoftDemodulator(config, -1.0),
+               std::invalid_argument);
+}
+
+TEST(BpskPassbandSoftTest, FeedsChaseDecoder) {
+  const int r = 4;
+  const harq::HammingEncoder encoder(r);
+  std::mt19937 rng(31);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<uint8_t> data(encoder.k());
+  for (auto& bit : data) {
+    bit = coin(rng) ? 1 : 0;
+  }
+  const auto codeword = encoder.EncodeExtended(data);
+
+  const auto config = SoftTestConfig();
+  const auto samples = NoisySamples(codeword, config, 0.5, 32);
+  harq::BpskPassbandSoftDemodulator demodulator(config);
+  std::vector<double> llr(codeword.size());
+  ASSERT_EQ(demodulator.Process(samples, llr), codeword.size());
+
+  harq::ChaseDecoder decoder(r, 2, harq::ProbeAlgorithm::Second);
+  std::vector<uint8_t> decoded(encoder.k());
+  decoder.Decode(std::span<const double>(llr), decoded);
+  EXPECT_EQ(decoded, data);
+}
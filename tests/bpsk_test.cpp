@@ -2,7 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <cstdint>
+#include <stdexcept>
 #include <vector>
 
 TEST(BpskModulatorTest, ModulatesBitsToSymbols) {
@@ -31,3 +33,104 @@ TEST(BpskDemodulatorTest, DemodulatesSymbolsToBits) {
 
   ASSERT_EQ(bits, expected);
 }
+
+namespace {
+
+std::vector<uint8_t> PatternBits(std::size_t size) {
+  std::vector<uint8_t> bits(size);
+  for (std::size_t i = 0; i < size; i++) {
+    bits[i] = static_cast<uint8_t>(((i * 5) ^ (i / 7)) & 1);
+  }
+  return bits;
+}
+
+std::vector<uint64_t> PackBits(const std::vector<uint8_t>& bits) {
+  std::vector<uint64_t> words((bits.size() + 63) / 64, 0);
+  for (std::size_t i = 0; i < bits.size(); i++) {
+    words[i / 64] |= uint64_t{bits[i]} << (i % 64);
+  }
+  return words;
+}
+
+constexpr harq::SimdLevel kLevels[] = {harq::SimdLevel::kScalar,
+                                       harq::SimdLevel::kAvx2};
+
+}  // namespace
+
+TEST(BpskKernelTest, MapMatchesReferenceOnAllPaths) {
+  for (std::size_t size : {0, 1, 3, 8, 63, 64, 65, 131}) {
+    const auto bits = PatternBits(size);
+    const auto words = PackBits(bits);
+    for (harq::SimdLevel level : kLevels) {
+      std::vector<double> symbols(size);
+      std::vector<float> symbols_f(size);
+      std::vector<double> packed(size);
+      std::vector<float> packed_f(size);
+      harq::BpskMap(bits, symbols, level);
+      harq::BpskMap(bits, symbols_f, level);
+      harq::BpskMapPacked(words, packed, level);
+      harq::BpskMapPacked(words, packed_f, level);
+      for (std::size_t i = 0; i < size; i++) {
+        const double expected = bits[i] ? 1.0 : -1.0;
+        ASSERT_EQ(symbols[i], expected) << size << " " << i;
+        ASSERT_EQ(symbols_f[i], static_cast<float>(expected));
+        ASSERT_EQ(packed[i], expected);
+        ASSERT_EQ(packed_f[i], static_cast<float>(expected));
+      }
+    }
+  }
+}
+
+TEST(BpskKernelTest, DemapMatchesReferenceOnAllPaths) {
+  for (std::size_t size : {1, 4, 7, 64, 100, 129}) {
+    std::vector<double> symbols(size);
+    for (std::size_t i = 0; i < size; i++) {
+      symbols[i] = std::sin(0.7 * static_cast<double>(i) + 0.3);
+    }
+    symbols[0] = -0.0;
+    const std::vector<float> symbols_f(symbols.begin(), symbols.end());
+    const auto expected = harq::BpskDemodulate(symbols);
+    ASSERT_EQ(expected[0], 1);
+    const auto expected_words = PackBits(expected);
+
+    for (harq::SimdLevel level : kLevels) {
+      std::vector<uint8_t> bits(size);
+      std::vector<uint8_t> bits_f(size);
+      harq::BpskDemap(symbols, bits, level);
+      harq::BpskDemap(symbols_f, bits_f, level);
+      EXPECT_EQ(bits, expected);
+      EXPECT_EQ(bits_f, expected);
+
+      std::vector<uint64_t> words(expected_words.size(), ~uint64_t{0});
+      std::vector<uint64_t> words_f(expected_words.size(), ~uint64_t{0});
+      harq::BpskDemapPacked(symbols, words, level);
+      harq::BpskDemapPacked(symbols_f, words_f, level);
+      EXPECT_EQ(words, expected_words);
+      EXPECT_EQ(words_f, expected_words);
+    }
+  }
+}
+
+TEST(BpskKernelTest, SoftDemapScalesInPlace) {
+  std::vector<double> values = {0.5, -1.0, 2.0};
+  harq::BpskDemapSoft(values, 0.25);
+  EXPECT_EQ(values, (std::vector<double>{4.0, -8.0, 16.0}));
+
+  std::vector<float> values_f = {1.0f, -0.5f};
+  harq::BpskDemapSoft(values_f, 2.0f);
+  EXPECT_EQ(values_f, (std::vector<float>{1.0f, -0.5f}));
+  EXPECT_THROW(harq::BpskDemapSoft(values, 0.0), std::invalid_argument);
+}
+
+TEST(BpskKernelTest, ValidationIsSeparatePass) {
+  const std::vector<uint8_t> bits = {0, 1, 3, 1};
+  EXPECT_THROW(harq::ValidateBits(bits), std::invalid_argument);
+  EXPECT_NO_THROW(harq::ValidateBits(PatternBits(100)));
+
+  std::vector<double> symbols(3);
+  EXPECT_THROW(harq::BpskMap(bits, symbols), std::invalid_argument);
+  std::vector<uint64_t> words(1);
+  std::vector<double> long_symbols(65);
+  EXPECT_THROW(harq::BpskMapPacked(words, long_symbols),
+               std::invalid_argument);
+}
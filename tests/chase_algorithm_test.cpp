@@ -4,6 +4,10 @@
 #include <stdexcept>
 #include <algorithm>
 #include <set>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
 
 // Предполагается, что у тебя есть chase_algorithm.hpp с объявлением функций
 #include "chase_algorithm.hpp"
@@ -57,6 +61,65 @@ TEST(GetNSmallestIndicesTest, EmptyInput) {
     EXPECT_THROW(get_n_smallest_indices({}, 1), std::invalid_argument);
 }
 
+// Эталон: устойчивая сортировка индексов по |x|.
+static std::vector<size_t> ReferenceSmallest(const std::vector<double>& v,
+                                             size_t t) {
+    std::vector<size_t> order(v.size());
+    for (size_t i = 0; i < v.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return std::abs(v[a]) < std::abs(v[b]);
+    });
+    order.resize(t);
+    return order;
+}
+
+TEST(SelectLeastReliableTest, MatchesStableSortForAllLengths) {
+    std::mt19937 rng(16);
+    std::uniform_int_distribution<int> level(-40, 40);
+    for (size_t n : {1u, 5u, 15u, 64u, 255u, 1023u}) {
+        std::vector<double> v(n);
+        std::vector<int8_t> v8(n);
+        std::vector<int16_t> v16(n);
+        for (size_t i = 0; i < n; i++) {
+            // Небольшой набор уровней даёт много равных значений.
+            v8[i] = static_cast<int8_t>(level(rng));
+            v16[i] = v8[i];
+            v[i] = v8[i];
+        }
+        for (size_t t : {1u, 2u, 3u, 7u, 64u}) {
+            if (t > n) continue;
+            const std::vector<size_t> expected = ReferenceSmallest(v, t);
+            std::vector<size_t> out(t), out8(t), out16(t);
+            SelectLeastReliable(v, out);
+            SelectLeastReliable(v8, out8);
+            SelectLeastReliable(v16, out16);
+            EXPECT_EQ(out, expected) << "n=" << n << " t=" << t;
+            EXPECT_EQ(out8, expected);
+            EXPECT_EQ(out16, expected);
+        }
+    }
+}
+
+TEST(SelectLeastReliableTest, HandlesInfiniteValues) {
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> v = {inf, -inf, inf, 2.0, inf};
+    std::vector<size_t> out(3);
+    SelectLeastReliable(v, out);
+    EXPECT_EQ(out, std::vector<size_t>({3, 0, 1}));
+}
+
+TEST(SelectLeastReliableTest, RejectsInvalidSelection) {
+    std::vector<double> v(100, 1.0);
+    std::vector<size_t> empty;
+    std::vector<size_t> too_many(65);
+    std::vector<size_t> longer(101);
+    EXPECT_THROW(SelectLeastReliable(v, empty), std::invalid_argument);
+    EXPECT_THROW(SelectLeastReliable(v, too_many), std::invalid_argument);
+    EXPECT_THROW(SelectLeastReliable(v, longer), std::invalid_argument);
+    // Обёртка сохраняет поддержку больших n.
+    EXPECT_EQ(get_n_smallest_indices(v, 100).size(), 100u);
+}
+
 // ------------------------------------------------------------------
 // 2. Тесты для generate_probe_sequences_1
 // ------------------------------------------------------------------
@@ -189,6 +252,36 @@ TEST(GenerateProbeSequences3Test, PrecariousZero) {
     // Пока оставим как есть — тест должен падать.
 }
 
+TEST(GenerateProbeSequences3Test, ManyUnreliablePositions) {
+    // d-1 = 79 > kMaxLeastReliable: позиции выбираются в куче.
+    const int n = 127;
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<double> rel(n);
+    for (double& value : rel) {
+        value = noise(rng);
+    }
+
+    auto seqs = generate_probe_sequences_3(n, 80, rel);
+    ASSERT_EQ(seqs.size(), 1u);
+    const auto indices = get_n_smallest_indices(rel, 79);
+    std::vector<uint8_t> expected(n, 0);
+    expected[indices[0]] = 1;
+    expected[indices[1]] = 1;
+    for (int i = 3; i < 79; i += 2) {
+        expected[indices[i]] = 1;
+    }
+    EXPECT_EQ(seqs[0], expected);
+
+    std::vector<uint8_t> message(n, 0);
+    const auto packed = CalculateCandidates(BitVector(message), 7, 80, rel,
+                                            ProbeAlgorithm::Third);
+    const auto bytes =
+        CalculateCandidates(message, 7, 80, rel, ProbeAlgorithm::Third);
+    ASSERT_EQ(packed.size(), 1u);
+    EXPECT_EQ(packed[0].ToBytes(), bytes[0]);
+}
+
 TEST(GenerateProbeSequences3Test, InvalidInput) {
     std::vector<double> rel = {0.1, 0.2};
     EXPECT_THROW(generate_probe_sequences_3(-1, 2, rel), std::invalid_argument);
@@ -217,4 +310,99 @@ TEST(GenerateProbeSequencesSanity, OnlyZerosAndOnes) {
     check(s1);
     check(s2);
     check(s3);
-}
\ No newline at end of file
+}
+// ------------------------------------------------------------------
+// 5. Кандидаты и выбор решения
+// ------------------------------------------------------------------
+
+TEST(CalculateCandidatesTest, CorrectsEveryProbedWord) {
+    // Кодовое слово (7,4) для {1,0,1,1} с ошибкой во второй позиции.
+    std::vector<uint8_t> received = {0, 0, 1, 0, 0, 1, 1};
+    std::vector<double> rel = {0.9, 0.1, 0.8, 0.7, 0.6, 0.5, 0.4};
+    auto candidates = CalculateCandidates(received, 3, 2, rel, ProbeAlgorithm::Second);
+
+    ASSERT_EQ(candidates.size(), 2u);
+    for (const auto& candidate : candidates) {
+        EXPECT_EQ(candidate, std::vector<uint8_t>({0, 1, 1, 0, 0, 1, 1}));
+    }
+}
+
+TEST(MakeDecisionTest, PicksClosestCandidate) {
+    std::vector<std::vector<uint8_t>> candidates = {{1, 1, 0}, {0, 1, 0}, {1, 0, 1}};
+    std::vector<double> soft = {0.1, 0.9, 0.2};
+    EXPECT_EQ(MakeDecision(candidates, soft), std::vector<uint8_t>({0, 1, 0}));
+    EXPECT_THROW(MakeDecision({}, soft), std::invalid_argument);
+}
+
+TEST(MakeDecisionTest, MatchesScalarDistance) {
+    // Мягкие решения выходят за [0, 1]; минимум должен совпасть с
+    // поэлементным подсчётом CalculateDistance.
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> value(-0.5, 1.5);
+    std::bernoulli_distribution bit(0.5);
+    for (int trial = 0; trial < 50; ++trial) {
+        const size_t n = 7 + trial % 40;
+        std::vector<double> soft(n);
+        for (double& s : soft) {
+            s = value(rng);
+        }
+        std::vector<std::vector<uint8_t>> candidates(9, std::vector<uint8_t>(n));
+        for (auto& candidate : candidates) {
+            for (auto& b : candidate) {
+                b = bit(rng);
+            }
+        }
+
+        size_t best = 0;
+        for (size_t i = 1; i < candidates.size(); ++i) {
+            if (CalculateDistance(candidates[i], soft).first <
+                CalculateDistance(candidates[best], soft).first) {
+                best = i;
+            }
+        }
+        EXPECT_EQ(MakeDecision(candidates, soft), candidates[best]);
+    }
+    EXPECT_THROW(MakeDecision({{0, 1}}, {0.5, 0.5, 0.5}), std::invalid_argument);
+}
+
+TEST(MakeDecisionTest, QuantizedLlrPicksLeastDiscrepancy) {
+    // Метрика по квантованным LLR: сумма |q_i| по позициям, где бит
+    // кандидата расходится с жёстким решением q_i >= 0.
+    std::mt19937 rng(29);
+    std::uniform_int_distribution<int> level(-127, 127);
+    std::bernoulli_distribution bit(0.5);
+    for (int trial = 0; trial < 50; ++trial) {
+        const size_t n = 7 + trial % 60;
+        std::vector<int8_t> llr8(n);
+        std::vector<int16_t> llr16(n);
+        for (size_t i = 0; i < n; ++i) {
+            llr8[i] = static_cast<int8_t>(level(rng));
+            llr16[i] = static_cast<int16_t>(llr8[i] * 200);
+        }
+        std::vector<std::vector<uint8_t>> candidates(9, std::vector<uint8_t>(n));
+        for (auto& candidate : candidates) {
+            for (auto& b : candidate) {
+                b = bit(rng);
+            }
+        }
+
+        size_t best = 0;
+        int best_metric = std::numeric_limits<int>::max();
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            int metric = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if ((llr8[i] >= 0) != (candidates[c][i] != 0)) {
+                    metric += std::abs(llr8[i]);
+                }
+            }
+            if (metric < best_metric) {
+                best_metric = metric;
+                best = c;
+            }
+        }
+        EXPECT_EQ(MakeDecision(candidates, std::span<const int8_t>(llr8)),
+                  candidates[best]);
+        EXPECT_EQ(MakeDecision(candidates, std::span<const int16_t>(llr16)),
+                  candidates[best]);
+    }
+}
@@ -0,0 +1,258 @@
+#include "chase_decoder.hpp"
+#include "bpsk.hpp"
+#include "hamming_decoder.hpp"
+#include "hamming_encoder.hpp"
+
+#include "test_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using harq::test::RandomBits;
+
+// Счётчик выделений памяти для проверки Decode без обращений к куче.
+// Считает только пока поднят флаг, чтобы не влиять на остальные тесты
+// общего бинарника.
+std::atomic<bool> g_count_allocations{false};
+std::atomic<long> g_allocations{0};
+
+// LLR без шума: +amplitude для бита 1, -amplitude для бита 0.
+std::vector<double> CleanLlr(const std::vector<uint8_t>& codeword,
+                             double amplitude) {
+  std::vector<double> llr(codeword.size());
+  for (size_t i = 0; i < codeword.size(); i++) {
+    llr[i] = codeword[i] == 1 ? amplitude : -amplitude;
+  }
+  return llr;
+}
+
+// Эталонный Chase-II: полный перебор кандидатов и выбор минимума метрики.
+std::vector<uint8_t> ReferenceChaseSecond(int r, int d,
+                                          const std::vector<double>& llr) {
+  harq::HammingDecoder decoder(r);
+  const int n = decoder.n();
+  const std::vector<double> reliability(llr.begin(), llr.begin() + n);
+
+  std::vector<uint8_t> hard(llr.size());
+  for (size_t i = 0; i < llr.size(); i++) {
+    hard[i] = llr[i] >= 0.0 ? 1 : 0;
+  }
+  const std::vector<uint8_t> hard_n(hard.begin(), hard.begin() + n);
+
+  double best_metric = INFINITY;
+  std::vector<uint8_t> best;
+  for (const auto& probe :
+       harq::generate_probe_sequences_2(n, d, reliability)) {
+    std::vector<uint8_t> candidate =
+        decoder.Correct(harq::AddErrorVector(hard_n, probe));
+    if (llr.size() > static_cast<size_t>(n)) {
+      uint8_t parity = 0;
+      for (uint8_t bit : candidate) {
+        parity ^= bit;
+      }
+      candidate.push_back(parity);
+    }
+
+    double metric = 0.0;
+    for (size_t i = 0; i < candidate.size(); i++) {
+      metric += candidate[i] != hard[i] ? std::abs(llr[i]) : 0.0;
+    }
+    if (metric < best_metric) {
+      best_metric = metric;
+      best = candidate;
+    }
+  }
+  best.resize(n);
+  return decoder.Decode(best);
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  if (g_count_allocations.load(std::memory_order_relaxed)) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+TEST(ChaseDecoderTest, DecodesCleanCodewords) {
+  std::mt19937 rng(1);
+  const harq::ProbeAlgorithm algorithms[] = {
+      harq::ProbeAlgorithm::First, harq::ProbeAlgorithm::Second,
+      harq::ProbeAlgorithm::ThirdNested};
+  for (int r = 3; r <= 7; r++) {
+    harq::HammingEncoder encoder(r);
+    for (auto algorithm : algorithms) {
+      harq::ChaseDecoder decoder(r, 4, algorithm);
+      std::vector<uint8_t> decoded(decoder.k());
+
+      const std::vector<uint8_t> message = RandomBits(rng, encoder.k());
+      decoder.Decode(CleanLlr(encoder.Encode(message), 4.0), decoded);
+      EXPECT_EQ(decoded, message);
+
+      decoder.Decode(CleanLlr(encoder.EncodeExtended(message), 4.0), decoded);
+      EXPECT_EQ(decoded, message);
+    }
+  }
+}
+
+TEST(ChaseDecoderTest, SecondAlgorithmCorrectsDoubleUnreliableError) {
+  harq::HammingEncoder encoder(3);
+  harq::ChaseDecoder decoder(3, 4, harq::ProbeAlgorithm::Second);
+  EXPECT_EQ(decoder.patterns(), 4);
+
+  const std::vector<uint8_t> message = {1, 0, 1, 1};
+  std::vector<double> llr = CleanLlr(encoder.Encode(message), 4.0);
+  // Две ошибки с малой надёжностью: жёсткий декодер Хэмминга их не исправит.
+  llr[1] = -llr[1] / 8.0;
+  llr[5] = -llr[5] / 8.0;
+
+  std::vector<uint8_t> decoded(decoder.k());
+  decoder.Decode(llr, decoded);
+  EXPECT_EQ(decoded, message);
+}
+
+TEST(ChaseDecoderTest, DecodeDoesNotAllocate) {
+  harq::HammingEncoder encoder(6);
+  harq::ChaseDecoder decoder(6, 6, harq::ProbeAlgorithm::Second);
+
+  std::mt19937 rng(2);
+  std::normal_distribution<double> noise(0.0, 0.7);
+  const std::vector<uint8_t> message = RandomBits(rng, encoder.k());
+  std::vector<double> llr = CleanLlr(encoder.Encode(message), 1.0);
+  for (double& value : llr) {
+    value += noise(rng);
+  }
+  std::vector<uint8_t> decoded(decoder.k());
+
+  decoder.Decode(llr, decoded);
+  const long before = g_allocations.load();
+  g_count_allocations.store(true);
+  for (int i = 0; i < 100; i++) {
+    decoder.Decode(llr, decoded);
+  }
+  g_count_allocations.store(false);
+  EXPECT_EQ(g_allocations.load(), before);
+}
+
+TEST(ChaseDecoderTest, ThrowsOnInvalidInput) {
+  EXPECT_THROW(harq::ChaseDecoder(3, 0, harq::ProbeAlgorithm::Second),
+               std::invalid_argument);
+  EXPECT_THROW(harq::ChaseDecoder(3, 1, harq::ProbeAlgorithm::First),
+               std::invalid_argument);
+
+  harq::ChaseDecoder decoder(3, 4, harq::ProbeAlgorithm::Second);
+  std::vector<uint8_t> decoded(decoder.k());
+  std::vector<double> short_llr(5, 1.0);
+  EXPECT_THROW(decoder.Decode(short_llr, decoded), std::invalid_argument);
+
+  std::vector<double> llr(7, 1.0);
+  std::vector<uint8_t> short_out(3);
+  EXPECT_THROW(decoder.Decode(llr, short_out), std::invalid_argument);
+}
+
+TEST(ChaseDecoderTest, StreamingSecondMatchesExhaustiveSearch) {
+  std::mt19937 rng(4);
+  std::normal_distribution<double> noise(0.0, 0.8);
+  for (int r = 3; r <= 5; r++) {
+    harq::HammingEncoder encoder(r);
+    for (int d : {2, 4, 6, 8}) {
+      harq::ChaseDecoder decoder(r, d, harq::ProbeAlgorithm::Second);
+      std::vector<uint8_t> decoded(decoder.k());
+
+      for (int trial = 0; trial < 50; trial++) {
+        const std::vector<uint8_t> message = RandomBits(rng, encoder.k());
+        std::vector<double> llr =
+            CleanLlr(encoder.EncodeExtended(message), 1.0);
+        for (double& value : llr) {
+          value += noise(rng);
+        }
+        if (trial % 2 == 0) {
+          llr.pop_back();
+        }
+
+        decoder.Decode(llr, decoded);
+        EXPECT_EQ(decoded, ReferenceChaseSecond(r, d, llr));
+      }
+    }
+  }
+}
+
+TEST(ChaseDecoderTest, QuantizedLlrMatchesDoublePath) {
+  std::mt19937 rng(13);
+  std::uniform_int_distribution<int> level(-127, 127);
+  const harq::ProbeAlgorithm algorithms[] = {
+      harq::ProbeAlgorithm::First, harq::ProbeAlgorithm::Second,
+      harq::ProbeAlgorithm::Third, harq::ProbeAlgorithm::ThirdNested};
+
+  for (auto algorithm : algorithms) {
+    harq::ChaseDecoder decoder(4, 4, algorithm);
+    for (int trial = 0; trial < 200; trial++) {
+      std::vector<int8_t> llr8(decoder.n() + 1);
+      std::vector<int16_t> llr16(llr8.size());
+      std::vector<double> llr(llr8.size());
+      for (size_t i = 0; i < llr8.size(); i++) {
+        llr8[i] = static_cast<int8_t>(level(rng));
+        llr16[i] = llr8[i];
+        llr[i] = llr8[i];
+      }
+
+      std::vector<uint8_t> expected(decoder.k());
+      std::vector<uint8_t> out8(decoder.k());
+      std::vector<uint8_t> out16(decoder.k());
+      decoder.Decode(llr, expected);
+      decoder.Decode(std::span<const int8_t>(llr8), out8);
+      decoder.Decode(std::span<const int16_t>(llr16), out16);
+      EXPECT_EQ(out8, expected);
+      EXPECT_EQ(out16, expected);
+    }
+  }
+}
+
+TEST(ChaseDecoderTest, ThirdVariantsFollowPatternTables) {
+  const int r = 4;
+  const int d = 4;
+  harq::ChaseDecoder single(r, d, harq::ProbeAlgorithm::Third);
+  harq::ChaseDecoder nested(r, d, harq::ProbeAlgorithm::ThirdNested);
+  EXPECT_EQ(single.patterns(),
+            harq::GetProbePatterns(single.n(), d, harq::ProbeAlgorithm::Third)
+                ->size());
+  EXPECT_EQ(single.patterns(), 1);
+  // m = 0, 1, 3.
+  EXPECT_EQ(nested.patterns(), 3);
+
+  // Третий алгоритм с одной последовательностью выбирает её исправленный
+  // кандидат, как CalculateCandidates.
+  std::mt19937 rng(17);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  harq::HammingDecoder hamming(r);
+  for (int trial = 0; trial < 20; trial++) {
+    std::vector<double> llr(single.n());
+    for (double& value : llr) {
+      value = noise(rng);
+    }
+    const auto candidates = harq::CalculateCandidates(
+        harq::BpskDemodulate(llr), r, d, llr, harq::ProbeAlgorithm::Third);
+    ASSERT_EQ(candidates.size(), 1u);
+    std::vector<uint8_t> decoded(single.k());
+    single.Decode(llr, decoded);
+    EXPECT_EQ(decoded, hamming.Decode(candidates[0]));
+  }
+}
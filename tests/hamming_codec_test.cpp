@@ -0,0 +1,89 @@
+#include "hamming_codec.hpp"
+
+#include "bit_packing.hpp"
+#include "hamming_decoder.hpp"
+#include "hamming_encoder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using Codec74 = harq::HammingCodec<3>;
+
+// Таблицы и кодирование вычисляются при компиляции.
+static_assert(Codec74::kN == 7 && Codec74::kK == 4);
+static_assert(Codec74::kParityCheckMasks[0] == 0b1010101);
+static_assert(Codec74::kDataMask == 0b1110100);
+static_assert(Codec74::Encode(0) == 0);
+static_assert(Codec74::Syndrome(Codec74::Encode(0b1011)) == 0);
+static_assert(Codec74::EncodeExtended(0b0001) == 0b10000111);
+static_assert(harq::HammingCodec<6>::kGeneratorRows.size() == 57);
+
+template <int R>
+void ExpectMatchesRuntimeCodec() {
+  using Codec = harq::HammingCodec<R>;
+  const harq::HammingEncoder encoder(R);
+  const harq::HammingDecoder decoder(R);
+
+  const auto& generator = encoder.generator_matrix();
+  for (int i = 0; i < Codec::kK; i++) {
+    uint64_t row = 0;
+    harq::PackBits(generator[i], std::span<uint64_t>(&row, 1));
+    EXPECT_EQ(Codec::kGeneratorRows[i], row) << "r=" << R << " row " << i;
+  }
+
+  std::mt19937_64 rng(R);
+  for (int trial = 0; trial < 200; trial++) {
+    const uint64_t data = rng() & harq::LowBitsMask(Codec::kK);
+    const uint64_t codeword = Codec::EncodeExtended(data);
+    ASSERT_EQ(Codec::Encode(data), codeword & harq::LowBitsMask(Codec::kN));
+
+    // Одна ошибка исправляется, две обнаруживаются.
+    const int first = static_cast<int>(rng() % (Codec::kN + 1));
+    uint64_t received = codeword ^ (uint64_t{1} << first);
+    uint64_t decoded = 0;
+    const auto status = Codec::Decode(received, true, decoded);
+    EXPECT_EQ(decoded, data);
+    EXPECT_EQ(status, first == Codec::kN
+                          ? harq::HammingDecoder::DecodeStatus::kParityCorrected
+                          : harq::HammingDecoder::DecodeStatus::kCorrected);
+
+    const int second = (first + 1) % (Codec::kN + 1);
+    received ^= uint64_t{1} << second;
+    EXPECT_EQ(Codec::Decode(received, true, decoded),
+              harq::HammingDecoder::DecodeStatus::kDetectedDouble);
+
+    // Многословный путь общего кода даёт те же решения.
+    std::vector<uint64_t> data_words(decoder.data_words() + 1, 0);
+    std::vector<uint64_t> codeword_words(decoder.codeword_words(), 0);
+    codeword_words[0] = codeword ^ (uint64_t{1} << first);
+    decoder.DecodePacked(codeword_words, true, data_words);
+    EXPECT_EQ(data_words[0], data);
+  }
+}
+
+}  // namespace
+
+TEST(HammingCodecTest, MatchesRuntimeEncoderAndDecoder) {
+  ExpectMatchesRuntimeCodec<2>();
+  ExpectMatchesRuntimeCodec<3>();
+  ExpectMatchesRuntimeCodec<4>();
+  ExpectMatchesRuntimeCodec<5>();
+  ExpectMatchesRuntimeCodec<6>();
+}
+
+TEST(HammingCodecTest, VisitDispatchesOnRuntimeR) {
+  for (int r = 2; r <= 6; r++) {
+    const int n = harq::VisitHammingCodec(
+        r, [](auto codec) { return decltype(codec)::kN; });
+    EXPECT_EQ(n, (1 << r) - 1);
+  }
+  EXPECT_THROW(harq::VisitHammingCodec(7, [](auto) { return 0; }),
+               std::invalid_argument);
+}
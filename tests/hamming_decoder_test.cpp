@@ -1,12 +1,25 @@
 #include "hamming_decoder.hpp"
 #include "hamming_encoder.hpp"
 
+#include "bit_packing.hpp"
+
+#include "test_util.hpp"
+
 #include <gtest/gtest.h>
 
 #include <cstdint>
+#include <random>
 #include <stdexcept>
 #include <vector>
 
+namespace {
+
+using harq::test::RandomBits;
+
+using Status = harq::HammingDecoder::DecodeStatus;
+
+}  // namespace
+
 TEST(HammingDecoderTest, CorrectsSingleError74) {
   harq::HammingEncoder encoder(3);
   harq::HammingDecoder decoder(3);
@@ -113,3 +126,161 @@ TEST(HammingDecoderTest, SecdedCorrectsParityBit74) {
   EXPECT_EQ(result.second,
             harq::HammingDecoder::DecodeStatus::kParityCorrected);
 }
+
+TEST(HammingDecoderTest, PackedSingleWordMatchesVectorPath) {
+  std::mt19937 rng(3);
+  for (int r = 2; r <= harq::HammingDecoder::kMaxSingleWordR; r++) {
+    harq::HammingEncoder encoder(r);
+    harq::HammingDecoder decoder(r);
+    std::uniform_int_distribution<int> position(0, encoder.n());
+
+    for (int trial = 0; trial < 64; trial++) {
+      const std::vector<uint8_t> message = RandomBits(rng, encoder.k());
+      std::vector<uint8_t> codeword = encoder.EncodeExtended(message);
+      const int errors = trial % 3;
+      int first = position(rng);
+      codeword[first] ^= errors > 0 ? 1 : 0;
+      if (errors == 2) {
+        int second = position(rng);
+        while (second == first) {
+          second = position(rng);
+        }
+        codeword[second] ^= 1;
+      }
+
+      uint64_t data = 0;
+      const Status status =
+          decoder.DecodePacked(harq::PackBits(codeword)[0], true, data);
+      const auto expected = decoder.DecodeWithStatus(codeword);
+      EXPECT_EQ(status, expected.second);
+      EXPECT_EQ(harq::UnpackBits({data}, decoder.k()), expected.first);
+
+      if (errors < 2) {
+        EXPECT_EQ(expected.first, message);
+      } else {
+        EXPECT_EQ(status, Status::kDetectedDouble);
+      }
+    }
+  }
+}
+
+TEST(HammingDecoderTest, PackedMultiwordCorrectsSingleError) {
+  std::mt19937 rng(5);
+  for (int r = 7; r <= 8; r++) {
+    harq::HammingEncoder encoder(r);
+    harq::HammingDecoder decoder(r);
+    std::uniform_int_distribution<int> position(0, encoder.n() - 1);
+
+    for (int trial = 0; trial < 32; trial++) {
+      const std::vector<uint8_t> message = RandomBits(rng, encoder.k());
+      std::vector<uint64_t> codeword(encoder.codeword_words());
+      encoder.EncodePacked(harq::PackBits(message), codeword);
+      harq::FlipBit(codeword, position(rng));
+
+      std::vector<uint64_t> data(decoder.data_words());
+      EXPECT_EQ(decoder.DecodePacked(codeword, false, data),
+                Status::kCorrected);
+      EXPECT_EQ(harq::UnpackBits(data, decoder.k()), message);
+      EXPECT_EQ(decoder.Decode(harq::UnpackBits(codeword, decoder.n())),
+                message);
+    }
+  }
+}
+
+TEST(HammingDecoderTest, SyndromePackedPointsAtErrorPosition) {
+  harq::HammingEncoder encoder(5);
+  harq::HammingDecoder decoder(5);
+
+  const uint64_t codeword = encoder.EncodePacked(0x2D5A3F1ull);
+  EXPECT_EQ(decoder.SyndromePacked(codeword), 0);
+  for (int pos = 1; pos <= decoder.n(); pos++) {
+    EXPECT_EQ(decoder.SyndromePacked(codeword ^ (uint64_t{1} << (pos - 1))),
+              pos);
+  }
+}
+
+TEST(HammingDecoderTest, DecodeBatchMatchesPackedDecode) {
+  std::mt19937 rng(9);
+  constexpr int kLanes = 4;
+  constexpr int kWords = harq::HammingDecoder::kWideBatchSize;
+  // При r >= 7 кодовое слово занимает несколько uint64_t.
+  for (int r = 3; r <= harq::HammingDecoder::kMaxBatchR; r++) {
+    for (bool extended : {false, true}) {
+      SCOPED_TRACE(testing::Message() << "r=" << r << " extended=" << extended);
+      harq::HammingEncoder encoder(r);
+      harq::HammingDecoder decoder(r);
+      const int n = decoder.n();
+      const int k = decoder.k();
+      const int length = extended ? n + 1 : n;
+      std::uniform_int_distribution<int> position(0, length - 1);
+
+      // Кодовые слова с 0, 1 или 2 ошибками.
+      std::vector<std::vector<uint64_t>> codewords(kWords);
+      for (int w = 0; w < kWords; w++) {
+        const auto data = harq::PackBits(RandomBits(rng, k));
+        codewords[w].assign(encoder.codeword_words(), 0);
+        if (extended) {
+          encoder.EncodeExtendedPacked(data, codewords[w]);
+        } else {
+          encoder.EncodePacked(data, codewords[w]);
+        }
+        const int first = position(rng);
+        if (w % 3 > 0) {
+          harq::FlipBit(codewords[w], first);
+        }
+        if (w % 3 == 2) {
+          int second = position(rng);
+          while (second == first) {
+            second = position(rng);
+          }
+          harq::FlipBit(codewords[w], second);
+        }
+      }
+
+      std::vector<uint64_t> slices(length * kLanes, 0);
+      for (int w = 0; w < kWords; w++) {
+        for (int p = 0; p < length; p++) {
+          slices[p * kLanes + w / 64] |=
+              static_cast<uint64_t>(harq::GetBit(codewords[w], p)) << (w % 64);
+        }
+      }
+
+      std::vector<uint64_t> data_slices(k * kLanes);
+      std::vector<Status> statuses(kWords);
+      decoder.DecodeBatch256(slices, extended, data_slices, statuses);
+
+      std::vector<uint64_t> narrow_slices(length);
+      std::vector<uint64_t> narrow_data(k);
+      std::vector<Status> narrow_statuses(harq::HammingDecoder::kBatchSize);
+      for (int p = 0; p < length; p++) {
+        narrow_slices[p] = slices[p * kLanes];
+      }
+      decoder.DecodeBatch(narrow_slices, extended, narrow_data,
+                          narrow_statuses);
+
+      for (int w = 0; w < kWords; w++) {
+        std::vector<uint64_t> expected_data(decoder.data_words());
+        const Status expected =
+            decoder.DecodePacked(codewords[w], extended, expected_data);
+        const int lane = w / 64;
+        const int bit = w % 64;
+        EXPECT_EQ(statuses[w], expected);
+        if (lane == 0) {
+          EXPECT_EQ(narrow_statuses[bit], expected);
+        }
+        if (expected == Status::kDetectedDouble) {
+          continue;
+        }
+        for (int i = 0; i < k; i++) {
+          const int expected_bit = harq::GetBit(expected_data, i);
+          ASSERT_EQ((data_slices[i * kLanes + lane] >> bit) & 1, expected_bit)
+              << "word " << w << " bit " << i;
+          if (lane == 0) {
+            ASSERT_EQ((narrow_data[i] >> bit) & 1, expected_bit)
+                << "word " << w << " bit " << i;
+          }
+        }
+      }
+    }
+  }
+}
@@ -1,13 +1,20 @@
 #include "hamming_encoder.hpp"
 
+#include "bit_packing.hpp"
+
+#include "test_util.hpp"
+
 #include <gtest/gtest.h>
 
 #include <cstdint>
+#include <random>
 #include <stdexcept>
 #include <vector>
 
 namespace {
 
+using harq::test::RandomBits;
+
 std::vector<std::vector<uint8_t>> BuildParityCheckMatrix(int r) {
   int n = (1 << r) - 1;
   std::vector<std::vector<uint8_t>> matrix(
@@ -38,6 +45,21 @@ std::vector<uint8_t> ComputeSyndrome(
   return syndrome;
 }
 
+// Эталонное кодирование: c = m * G над GF(2) поэлементно.
+std::vector<uint8_t> EncodeWithGenerator(
+    const std::vector<std::vector<uint8_t>>& generator,
+    const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> codeword(generator[0].size(), 0);
+  for (size_t i = 0; i < data.size(); i++) {
+    if (data[i] == 1) {
+      for (size_t j = 0; j < codeword.size(); j++) {
+        codeword[j] ^= generator[i][j];
+      }
+    }
+  }
+  return codeword;
+}
+
 }  // namespace
 
 TEST(HammingEncoderTest, GeneratorMatrixSize) {
@@ -93,3 +115,48 @@ TEST(HammingEncoderTest, EncodesExtendedCodeword74) {
   }
   EXPECT_EQ(codeword.back(), parity);
 }
+
+TEST(HammingEncoderTest, PackedMatchesGeneratorSingleWord) {
+  std::mt19937 rng(7);
+  for (int r = 2; r <= harq::HammingEncoder::kMaxSingleWordR; r++) {
+    harq::HammingEncoder encoder(r);
+    for (int trial = 0; trial < 64; trial++) {
+      const std::vector<uint8_t> message = RandomBits(rng, encoder.k());
+      const std::vector<uint8_t> reference =
+          EncodeWithGenerator(encoder.generator_matrix(), message);
+
+      const uint64_t packed_data = harq::PackBits(message)[0];
+      const uint64_t packed = encoder.EncodePacked(packed_data);
+      const uint64_t extended = encoder.EncodeExtendedPacked(packed_data);
+
+      EXPECT_EQ(harq::UnpackBits({packed}, encoder.n()), reference);
+      EXPECT_EQ(encoder.Encode(message), reference);
+      EXPECT_EQ(harq::UnpackBits({extended}, encoder.n() + 1),
+                encoder.EncodeExtended(message));
+    }
+  }
+}
+
+TEST(HammingEncoderTest, PackedMatchesGeneratorMultiword) {
+  std::mt19937 rng(11);
+  for (int r = 2; r <= 8; r++) {
+    harq::HammingEncoder encoder(r);
+    for (int trial = 0; trial < 16; trial++) {
+      const std::vector<uint8_t> message = RandomBits(rng, encoder.k());
+      std::vector<uint64_t> codeword(encoder.codeword_words());
+
+      encoder.EncodePacked(harq::PackBits(message), codeword);
+      EXPECT_EQ(harq::UnpackBits(codeword, encoder.n()),
+                EncodeWithGenerator(encoder.generator_matrix(), message));
+
+      encoder.EncodeExtendedPacked(harq::PackBits(message), codeword);
+      EXPECT_EQ(harq::UnpackBits(codeword, encoder.n() + 1),
+                encoder.EncodeExtended(message));
+    }
+  }
+}
+
+TEST(HammingEncoderTest, SingleWordPackedRejectsLargeR) {
+  harq::HammingEncoder encoder(7);
+  EXPECT_THROW(encoder.EncodePacked(uint64_t{1}), std::invalid_argument);
+}
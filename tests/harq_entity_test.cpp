@@ -0,0 +1,129 @@
+#include "harq_entity.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "chase_decoder.hpp"
+
+TEST(HarqEntityTest, AllocatesAndReleasesProcesses) {
+  harq::HarqEntity entity(3, 3, 3, harq::ProbeAlgorithm::Second, 4);
+
+  EXPECT_EQ(entity.Allocate(), 0);
+  EXPECT_EQ(entity.Allocate(), 1);
+  EXPECT_EQ(entity.Allocate(), 2);
+  EXPECT_EQ(entity.Allocate(), -1);
+  EXPECT_EQ(entity.active(), 3);
+
+  entity.Release(1);
+  EXPECT_EQ(entity.active(), 2);
+  EXPECT_THROW(entity.Release(1), std::invalid_argument);
+  EXPECT_EQ(entity.Allocate(), 1);
+}
+
+TEST(HarqEntityTest, SoftBuffersAreCacheAligned) {
+  harq::HarqEntity entity(5, 4, 4, harq::ProbeAlgorithm::Second, 2, true);
+  EXPECT_EQ(entity.length(), 16);
+  EXPECT_EQ(entity.stride() % 8, 0u);
+
+  for (int i = 0; i < entity.capacity(); i++) {
+    const int process = entity.Allocate();
+    const auto address =
+        reinterpret_cast<std::uintptr_t>(entity.soft_buffer(process).data());
+    EXPECT_EQ(address % 64, 0u);
+  }
+}
+
+TEST(HarqEntityTest, SlotDecodesPendingProcesses) {
+  const int kProcesses = 16;
+  harq::HarqEntity entity(kProcesses, 3, 3, harq::ProbeAlgorithm::Second, 2);
+  harq::ChaseDecoder reference(3, 3, harq::ProbeAlgorithm::Second);
+
+  std::mt19937 rng(12);
+  std::normal_distribution<double> value(0.0, 2.0);
+  std::vector<std::vector<double>> soft(kProcesses,
+                                        std::vector<double>(7, 0.0));
+  for (int i = 0; i < kProcesses; i++) {
+    ASSERT_EQ(entity.Allocate(), i);
+  }
+  // Два раунда для чётных процессов, один — для нечётных.
+  for (int round = 0; round < 2; round++) {
+    for (int process = 0; process < kProcesses; process++) {
+      if (round == 1 && process % 2 == 1) {
+        continue;
+      }
+      std::vector<double> llr(7);
+      for (double& x : llr) {
+        x = value(rng);
+      }
+      entity.Receive(process, llr);
+      for (int i = 0; i < 7; i++) {
+        soft[process][i] += llr[i];
+      }
+    }
+  }
+
+  EXPECT_EQ(entity.ProcessSlot(), kProcesses);
+  EXPECT_EQ(entity.ProcessSlot(), 0);
+  for (int process = 0; process < kProcesses; process++) {
+    std::vector<uint8_t> expected(4);
+    reference.Decode(soft[process], expected);
+    const std::span<const uint8_t> decoded = entity.decoded(process);
+    EXPECT_EQ(std::vector<uint8_t>(decoded.begin(), decoded.end()), expected);
+    EXPECT_EQ(entity.rounds(process), process % 2 == 0 ? 2 : 1);
+  }
+}
+
+TEST(HarqEntityTest, ReleasedProcessLeavesSlotQueue) {
+  harq::HarqEntity entity(4, 3, 3, harq::ProbeAlgorithm::Second, 2);
+  const int first = entity.Allocate();
+  const int second = entity.Allocate();
+  const std::vector<double> llr(7, 1.0);
+
+  entity.Receive(first, llr);
+  entity.Receive(second, llr, 0.5);
+  entity.Release(first);
+  EXPECT_EQ(entity.ProcessSlot(), 1);
+  EXPECT_DOUBLE_EQ(entity.soft_buffer(second)[0], 0.5);
+
+  // Повторно выделенный процесс получает чистый буфер.
+  EXPECT_EQ(entity.Allocate(), first);
+  EXPECT_EQ(entity.rounds(first), 0);
+  EXPECT_DOUBLE_EQ(entity.soft_buffer(first)[0], 0.0);
+}
+
+TEST(HarqEntityTest, ReallocatedProcessHidesPreviousDecision) {
+  harq::HarqEntity entity(2, 3, 3, harq::ProbeAlgorithm::Second, 2);
+  const int process = entity.Allocate();
+  // Все LLR положительны: декодируется слово из единиц.
+  entity.Receive(process, std::vector<double>(7, 4.0));
+  ASSERT_EQ(entity.ProcessSlot(), 1);
+  for (uint8_t bit : entity.decoded(process)) {
+    ASSERT_EQ(bit, 1);
+  }
+
+  entity.Release(process);
+  ASSERT_EQ(entity.Allocate(), process);
+  for (uint8_t bit : entity.decoded(process)) {
+    EXPECT_EQ(bit, 0);
+  }
+}
+
+TEST(HarqEntityTest, RejectsInvalidInput) {
+  EXPECT_THROW(harq::HarqEntity(0, 3, 3, harq::ProbeAlgorithm::Second, 1),
+               std::invalid_argument);
+
+  harq::HarqEntity entity(2, 3, 3, harq::ProbeAlgorithm::Second, 1);
+  const std::vector<double> llr(7, 1.0);
+  EXPECT_THROW(entity.Receive(0, llr), std::invalid_argument);
+
+  const int process = entity.Allocate();
+  EXPECT_THROW(entity.Receive(process, std::vector<double>(6, 1.0)),
+               std::invalid_argument);
+  entity.Receive(process, llr);
+  EXPECT_THROW(entity.Receive(process, llr), std::invalid_argument);
+  EXPECT_THROW(entity.soft_buffer(5), std::invalid_argument);
+}
@@ -0,0 +1,162 @@
+#include "harq_process.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "bpsk.hpp"
+#include "hamming_encoder.hpp"
+
+TEST(HarqProcessTest, CombinesRetransmissionsInSoftBuffer) {
+  harq::HarqProcess process(3, 3, harq::ProbeAlgorithm::Second, 3);
+  const std::vector<double> first = {1.0, -2.0, 0.5, -0.5, 3.0, -1.0, 2.0};
+  const std::vector<double> second = {0.5, 1.0, -1.5, -0.5, 1.0, 2.0, -1.0};
+
+  process.Receive(first);
+  process.Receive(second);
+
+  ASSERT_EQ(process.round(), 2);
+  const std::span<const double> soft = process.soft_buffer();
+  for (size_t i = 0; i < first.size(); i++) {
+    EXPECT_DOUBLE_EQ(soft[i], first[i] + second[i]);
+  }
+
+  process.Reset();
+  EXPECT_EQ(process.round(), 0);
+  EXPECT_DOUBLE_EQ(process.soft_buffer()[0], 0.0);
+}
+
+TEST(HarqProcessTest, DecodesTransmitResult) {
+  harq::HammingEncoder encoder(3);
+  const std::vector<uint8_t> data = {1, 0, 1, 1};
+  const std::vector<double> symbols =
+      harq::BpskModulate(encoder.Encode(data));
+
+  harq::AwgnChannel channel(12.0, 3);
+  harq::HarqProcess process(3, 3, harq::ProbeAlgorithm::Second, 2);
+  process.Receive(channel.Transmit(symbols).second);
+
+  const std::span<const uint8_t> decoded = process.decoded();
+  EXPECT_EQ(std::vector<uint8_t>(decoded.begin(), decoded.end()), data);
+}
+
+TEST(HarqProcessTest, RetransmissionsRaiseSuccessRate) {
+  harq::HammingEncoder encoder(4);
+  std::vector<uint8_t> data(encoder.k());
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>((i * 5 + 1) % 3 == 0);
+  }
+  const std::vector<double> symbols =
+      harq::BpskModulate(encoder.EncodeExtended(data));
+
+  harq::AwgnChannel channel(-1.0, 11);
+  harq::HarqProcess single(4, 4, harq::ProbeAlgorithm::Second, 1, true);
+  harq::HarqProcess combined(4, 4, harq::ProbeAlgorithm::Second, 4, true);
+
+  int single_successes = 0;
+  int combined_successes = 0;
+  int combined_rounds = 0;
+  for (int frame = 0; frame < 400; frame++) {
+    single_successes += single.Transmit(data, symbols, channel).success;
+    const harq::HarqResult result = combined.Transmit(data, symbols, channel);
+    combined_successes += result.success;
+    combined_rounds += result.rounds;
+    EXPECT_LE(result.rounds, 4);
+  }
+
+  EXPECT_GT(combined_successes, single_successes);
+  EXPECT_GT(combined_rounds, 400);
+}
+
+TEST(HarqProcessTest, IncrementalRedundancyPuncturingTables) {
+  harq::HarqProcess process(3, 4, harq::ProbeAlgorithm::Second, 3, true,
+                            harq::HarqMode::kIncrementalRedundancy);
+
+  // Данные (позиции 3, 5, 6, 7) и паритеты 1, 2; затем паритет 4 и общий.
+  const std::span<const int> first = process.RoundPositions(0);
+  const std::span<const int> second = process.RoundPositions(1);
+  const std::span<const int> third = process.RoundPositions(2);
+  EXPECT_EQ(std::vector<int>(first.begin(), first.end()),
+            (std::vector<int>{2, 4, 5, 6, 0, 1}));
+  EXPECT_EQ(std::vector<int>(second.begin(), second.end()),
+            (std::vector<int>{3, 7}));
+  EXPECT_EQ(std::vector<int>(third.begin(), third.end()),
+            std::vector<int>(first.begin(), first.end()));
+
+  // Непереданные позиции остаются стёртыми до следующего раунда.
+  process.Receive(std::vector<double>(6, 2.0));
+  EXPECT_DOUBLE_EQ(process.soft_buffer()[3], 0.0);
+  EXPECT_DOUBLE_EQ(process.soft_buffer()[7], 0.0);
+  EXPECT_DOUBLE_EQ(process.soft_buffer()[4], 2.0);
+  EXPECT_THROW(process.Receive(std::vector<double>(6, 1.0)),
+               std::invalid_argument);
+  process.Receive(std::vector<double>{-1.0, 3.0});
+  EXPECT_DOUBLE_EQ(process.soft_buffer()[3], -1.0);
+  EXPECT_DOUBLE_EQ(process.soft_buffer()[7], 3.0);
+}
+
+TEST(HarqProcessTest, IncrementalRedundancySendsFewerSymbols) {
+  harq::HammingEncoder encoder(4);
+  std::vector<uint8_t> data(encoder.k());
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(i % 2);
+  }
+  const std::vector<double> symbols =
+      harq::BpskModulate(encoder.EncodeExtended(data));
+
+  harq::AwgnChannel channel(12.0, 4);
+  harq::HarqProcess process(4, 4, harq::ProbeAlgorithm::Second, 4, true,
+                            harq::HarqMode::kIncrementalRedundancy);
+  const harq::HarqResult result = process.Transmit(data, symbols, channel);
+
+  EXPECT_TRUE(result.success);
+  EXPECT_EQ(result.rounds, 1);
+  EXPECT_EQ(result.symbols, 13);
+}
+
+TEST(HarqProcessTest, QuantizedBufferSaturates) {
+  harq::HarqProcess process(3, 3, harq::ProbeAlgorithm::Second, 4);
+  process.SetQuantizer(harq::LlrQuantizer(6, 4.0));
+  ASSERT_TRUE(process.quantized());
+
+  const std::vector<double> llr = {5.0, -5.0, 0.3, -0.3, 5.0, -5.0, 5.0};
+  process.Receive(llr);
+  process.Receive(llr);
+
+  // 5.0 * 4 = 20 на раунд, сумма 40 насыщается до 31.
+  const std::span<const int8_t> soft = process.quantized_buffer();
+  EXPECT_EQ(soft[0], 31);
+  EXPECT_EQ(soft[1], -31);
+  EXPECT_EQ(soft[2], 2);
+
+  // Решение совпадает с декодированием тех же уровней в double.
+  harq::ChaseDecoder reference(3, 3, harq::ProbeAlgorithm::Second);
+  std::vector<uint8_t> expected(4);
+  reference.Decode(std::vector<double>(soft.begin(), soft.end()), expected);
+  const std::span<const uint8_t> decoded = process.decoded();
+  EXPECT_EQ(std::vector<uint8_t>(decoded.begin(), decoded.end()), expected);
+
+  EXPECT_THROW(process.SetQuantizer(harq::LlrQuantizer(10, 4.0)),
+               std::invalid_argument);
+}
+
+TEST(HarqProcessTest, RejectsInvalidInput) {
+  EXPECT_THROW(harq::HarqProcess(3, 3, harq::ProbeAlgorithm::Second, 0),
+               std::invalid_argument);
+  EXPECT_THROW(harq::HarqProcess(3, 3, harq::ProbeAlgorithm::Second, 2, false,
+                                 harq::HarqMode::kIncrementalRedundancy),
+               std::invalid_argument);
+
+  harq::HarqProcess process(3, 3, harq::ProbeAlgorithm::Second, 1);
+  const std::vector<double> llr(7, 1.0);
+  EXPECT_THROW(process.Receive(std::vector<double>(8, 1.0)),
+               std::invalid_argument);
+  process.Receive(llr);
+  EXPECT_THROW(process.Receive(llr), std::invalid_argument);
+
+  harq::AwgnChannel channel(3.0);
+  EXPECT_THROW(process.Transmit(std::vector<uint8_t>(3, 0), llr, channel),
+               std::invalid_argument);
+}
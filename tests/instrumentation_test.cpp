@@ -0,0 +1,102 @@
+#include "instrumentation.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "awgn_channel.hpp"
+#include "bpsk.hpp"
+#include "chase_decoder.hpp"
+#include "hamming_decoder.hpp"
+#include "hamming_encoder.hpp"
+#include "harq_process.hpp"
+
+namespace instr = harq::instrumentation;
+
+TEST(InstrumentationTest, AggregatesCountersAcrossThreads) {
+  instr::Reset();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 1000; i++) {
+        instr::Count(instr::Counter::kCandidates);
+      }
+      instr::CountSuccessRounds(2);
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // Блоки завершившихся потоков остаются в сумме.
+  const instr::Snapshot snapshot = instr::Collect();
+  EXPECT_EQ(snapshot.counter(instr::Counter::kCandidates), 4000u);
+  EXPECT_EQ(snapshot.success_rounds[1], 4u);
+  EXPECT_DOUBLE_EQ(snapshot.mean_success_rounds(), 2.0);
+
+  instr::Reset();
+  EXPECT_EQ(instr::Collect().counter(instr::Counter::kCandidates), 0u);
+}
+
+TEST(InstrumentationTest, HotPathsAreSilentWhenCompiledOut) {
+  if (instr::kEnabled) {
+    GTEST_SKIP() << "Instrumentation is compiled in.";
+  }
+  instr::Reset();
+  harq::ChaseDecoder decoder(3, 4, harq::ProbeAlgorithm::First);
+  const std::vector<double> llr = {1.0, -0.5, 2.0, 0.1, -1.0, 0.3, -2.0};
+  std::vector<uint8_t> out(decoder.k());
+  decoder.Decode(llr, out);
+
+  const instr::Snapshot snapshot = instr::Collect();
+  for (uint64_t value : snapshot.counters) {
+    EXPECT_EQ(value, 0u);
+  }
+  for (uint64_t value : snapshot.stage_calls) {
+    EXPECT_EQ(value, 0u);
+  }
+}
+
+TEST(InstrumentationTest, CountsDecoderAndHarqEvents) {
+  if (!instr::kEnabled) {
+    GTEST_SKIP() << "Built without HARQ_ENABLE_INSTRUMENTATION.";
+  }
+  instr::Reset();
+
+  const harq::HammingEncoder encoder(3);
+  const harq::HammingDecoder hamming(3);
+  const std::vector<uint8_t> data = {1, 0, 1, 1};
+  auto codeword = encoder.Encode(data);
+  codeword[2] ^= 1;
+  hamming.Decode(codeword);
+
+  harq::ChaseDecoder chase(3, 4, harq::ProbeAlgorithm::First);
+  const std::vector<double> llr = {1.0, -0.5, 2.0, 0.1, -1.0, 0.3, -2.0};
+  std::vector<uint8_t> out(chase.k());
+  chase.Decode(llr, out);
+
+  harq::AwgnChannel channel(20.0, 3);
+  harq::HarqProcess process(3, 3, harq::ProbeAlgorithm::Second, 4);
+  const auto symbols = harq::BpskModulate(encoder.Encode(data));
+  ASSERT_TRUE(process.Transmit(data, symbols, channel).success);
+
+  const instr::Snapshot snapshot = instr::Collect();
+  const auto corrected =
+      static_cast<int>(harq::HammingDecoder::DecodeStatus::kCorrected);
+  EXPECT_GE(snapshot.statuses[corrected], 1u);
+  EXPECT_EQ(snapshot.counter(instr::Counter::kCandidates),
+            static_cast<uint64_t>(chase.patterns()) + 2);
+  EXPECT_GE(snapshot.counter(instr::Counter::kDistinctCandidates), 2u);
+  EXPECT_LE(snapshot.counter(instr::Counter::kDistinctCandidates),
+            snapshot.counter(instr::Counter::kCandidates));
+  EXPECT_EQ(snapshot.counter(instr::Counter::kHarqSuccesses), 1u);
+  EXPECT_EQ(snapshot.success_rounds[0], 1u);
+  EXPECT_EQ(snapshot.stage_calls[static_cast<int>(
+                instr::Stage::kChaseDecode)],
+            2u);
+  EXPECT_EQ(snapshot.stage_calls[static_cast<int>(instr::Stage::kChannel)],
+            1u);
+  EXPECT_GT(snapshot.cycles_per_call(instr::Stage::kChaseDecode), 0.0);
+}
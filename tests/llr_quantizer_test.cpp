@@ -0,0 +1,58 @@
+#include "llr_quantizer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+TEST(LlrQuantizerTest, RoundsAndSaturates) {
+  harq::LlrQuantizer quantizer(6, 4.0);
+  EXPECT_EQ(quantizer.max_level(), 31);
+
+  EXPECT_EQ(quantizer.Quantize(0.0), 0);
+  EXPECT_EQ(quantizer.Quantize(1.1), 4);
+  EXPECT_EQ(quantizer.Quantize(-1.2), -5);
+  EXPECT_EQ(quantizer.Quantize(100.0), 31);
+  EXPECT_EQ(quantizer.Quantize(-100.0), -31);
+  EXPECT_DOUBLE_EQ(quantizer.Dequantize(6), 1.5);
+}
+
+TEST(LlrQuantizerTest, KeepsHardDecisionOfTinyLlr) {
+  harq::LlrQuantizer quantizer(6, 4.0);
+  EXPECT_EQ(quantizer.Quantize(-0.01), -1);
+  EXPECT_EQ(quantizer.Quantize(0.01), 0);
+  EXPECT_EQ(quantizer.Quantize(-0.2), -1);
+
+  const std::vector<double> received = {-1e-6, 1e-6, -0.1};
+  std::vector<int8_t> out8(received.size());
+  quantizer.Quantize(received, out8);
+  EXPECT_EQ(out8, (std::vector<int8_t>{-1, 0, -1}));
+}
+
+TEST(LlrQuantizerTest, QuantizesBuffersWithGain) {
+  harq::LlrQuantizer quantizer(8, 2.0);
+  const std::vector<double> received = {0.5, -0.25, 40.0, -1e9};
+
+  std::vector<int8_t> out8(received.size());
+  std::vector<int16_t> out16(received.size());
+  quantizer.Quantize(received, out8, 3.0);
+  quantizer.Quantize(received, out16, 3.0);
+
+  EXPECT_EQ(out8, (std::vector<int8_t>{3, -2, 127, -127}));
+  EXPECT_EQ(out16, (std::vector<int16_t>{3, -2, 127, -127}));
+}
+
+TEST(LlrQuantizerTest, RejectsInvalidParameters) {
+  EXPECT_THROW(harq::LlrQuantizer(1, 1.0), std::invalid_argument);
+  EXPECT_THROW(harq::LlrQuantizer(17, 1.0), std::invalid_argument);
+  EXPECT_THROW(harq::LlrQuantizer(8, 0.0), std::invalid_argument);
+
+  harq::LlrQuantizer wide(12, 1.0);
+  std::vector<int8_t> out8(2);
+  EXPECT_THROW(wide.Quantize(std::vector<double>{1.0, 2.0}, out8),
+               std::invalid_argument);
+  std::vector<int16_t> out16(3);
+  EXPECT_THROW(wide.Quantize(std::vector<double>{1.0, 2.0}, out16),
+               std::invalid_argument);
+}
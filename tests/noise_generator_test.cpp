@@ -0,0 +1,73 @@
+#include "noise_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+TEST(NoiseGeneratorTest, ReproducibleForSeedAndStream) {
+  harq::GaussianNoise first(42, 3);
+  harq::GaussianNoise second(42, 3);
+  harq::GaussianNoise other_stream(42, 4);
+
+  std::vector<double> a(1000);
+  std::vector<double> b(1000);
+  std::vector<double> c(1000);
+  first.Fill(a, 1.0);
+  second.Fill(b, 1.0);
+  other_stream.Fill(c, 1.0);
+
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+}
+
+TEST(NoiseGeneratorTest, GaussianMoments) {
+  harq::GaussianNoise noise(1);
+  const double sigma = 0.5;
+  std::vector<double> samples(1 << 20);
+  noise.Fill(samples, sigma);
+
+  double sum = 0.0;
+  double sum_sq = 0.0;
+  long outliers = 0;
+  for (double x : samples) {
+    sum += x;
+    sum_sq += x * x;
+    outliers += std::abs(x) > 3.0 * sigma ? 1 : 0;
+  }
+  const double count = static_cast<double>(samples.size());
+  const double mean = sum / count;
+  const double variance = sum_sq / count - mean * mean;
+
+  EXPECT_NEAR(mean, 0.0, 5e-3);
+  EXPECT_NEAR(variance, sigma * sigma, 5e-3);
+  // P(|X| > 3 sigma) = 0.0027 для нормального распределения.
+  EXPECT_NEAR(static_cast<double>(outliers) / count, 0.0027, 5e-4);
+}
+
+TEST(NoiseGeneratorTest, AddToMatchesFill) {
+  harq::GaussianNoise fill_noise(7);
+  harq::GaussianNoise add_noise(7);
+
+  std::vector<float> noise(257);
+  fill_noise.Fill(noise, 2.0f);
+  std::vector<float> samples(257, 1.0f);
+  add_noise.AddTo(samples, 2.0f);
+
+  for (size_t i = 0; i < samples.size(); i++) {
+    EXPECT_FLOAT_EQ(samples[i], 1.0f + noise[i]);
+  }
+}
+
+TEST(NoiseGeneratorTest, UniformDoublesInUnitInterval) {
+  harq::Xoshiro256 engine(5);
+  double sum = 0.0;
+  for (int i = 0; i < 100000; i++) {
+    const double u = engine.NextDouble();
+    ASSERT_GE(u, 0.0);
+    ASSERT_LT(u, 1.0);
+    sum += u;
+  }
+  EXPECT_NEAR(sum / 100000.0, 0.5, 5e-3);
+}
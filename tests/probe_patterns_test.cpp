@@ -0,0 +1,85 @@
+#include "probe_patterns.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(ProbePatternsTest, FirstStoresCombinationPositions) {
+  const auto table = harq::GetProbePatterns(4, 4, harq::ProbeAlgorithm::First);
+  // Нулевая последовательность и C(4, 2) = 6 сочетаний.
+  ASSERT_EQ(table->size(), 7);
+  EXPECT_EQ(table->ranks(), 0);
+  EXPECT_TRUE(table->Pattern(0).empty());
+
+  const std::span<const int> first = table->Pattern(1);
+  EXPECT_EQ(std::vector<int>(first.begin(), first.end()),
+            (std::vector<int>{2, 3}));
+  const std::span<const int> last = table->Pattern(6);
+  EXPECT_EQ(std::vector<int>(last.begin(), last.end()),
+            (std::vector<int>{0, 1}));
+}
+
+TEST(ProbePatternsTest, SecondAndThirdStoreRanks) {
+  const auto second =
+      harq::GetProbePatterns(15, 6, harq::ProbeAlgorithm::Second);
+  EXPECT_EQ(second->size(), 8);
+  EXPECT_EQ(second->ranks(), 3);
+  const std::span<const int> five = second->Pattern(5);
+  EXPECT_EQ(std::vector<int>(five.begin(), five.end()),
+            (std::vector<int>{0, 2}));
+
+  const auto third = harq::GetProbePatterns(15, 6, harq::ProbeAlgorithm::Third);
+  EXPECT_EQ(third->size(), 1);
+  EXPECT_EQ(third->ranks(), 5);
+  const std::span<const int> ranks = third->Pattern(0);
+  EXPECT_EQ(std::vector<int>(ranks.begin(), ranks.end()),
+            (std::vector<int>{0, 1, 3}));
+
+  // Префиксы длины m = 0, 1, 3, 5.
+  const auto nested =
+      harq::GetProbePatterns(15, 6, harq::ProbeAlgorithm::ThirdNested);
+  EXPECT_EQ(nested->size(), 4);
+  EXPECT_EQ(nested->ranks(), 5);
+  EXPECT_TRUE(nested->Pattern(0).empty());
+  const std::span<const int> longest = nested->Pattern(3);
+  EXPECT_EQ(std::vector<int>(longest.begin(), longest.end()),
+            (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(ProbePatternsTest, CacheSharesOneTableAcrossThreads) {
+  const auto expected =
+      harq::GetProbePatterns(31, 4, harq::ProbeAlgorithm::First);
+  EXPECT_EQ(harq::GetProbePatterns(31, 4, harq::ProbeAlgorithm::First),
+            expected);
+  EXPECT_NE(harq::GetProbePatterns(31, 4, harq::ProbeAlgorithm::Second),
+            expected);
+
+  std::vector<std::shared_ptr<const harq::ProbePatternTable>> seen(8);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < seen.size(); t++) {
+    threads.emplace_back([&seen, t] {
+      seen[t] = harq::GetProbePatterns(63, 6, harq::ProbeAlgorithm::First);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& table : seen) {
+    EXPECT_EQ(table, seen[0]);
+  }
+  EXPECT_EQ(seen[0]->size(), 39712);
+}
+
+TEST(ProbePatternsTest, RejectsInvalidParameters) {
+  EXPECT_THROW(harq::GetProbePatterns(2, 1, harq::ProbeAlgorithm::First),
+               std::invalid_argument);
+  EXPECT_THROW(harq::GetProbePatterns(2, 6, harq::ProbeAlgorithm::Second),
+               std::invalid_argument);
+  EXPECT_THROW(harq::GetProbePatterns(7, 1, harq::ProbeAlgorithm::Third),
+               std::invalid_argument);
+  EXPECT_THROW(harq::GetProbePatterns(255, 16, harq::ProbeAlgorithm::First),
+               std::invalid_argument);
+}
@@ -0,0 +1,186 @@
+#include "simulator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+harq::SimulationConfig SmallConfig() {
+  harq::SimulationConfig config;
+  config.r = 3;
+  config.batch_frames = 64;
+  config.max_frames = 2000;
+  config.target_frame_errors = 0;
+  return config;
+}
+
+}  // namespace
+
+TEST(SimulatorTest, ResultDoesNotDependOnThreadCount) {
+  harq::SimulationConfig config = SmallConfig();
+  config.threads = 1;
+  const harq::SimulationPoint single =
+      harq::Simulator(config).RunPoint(harq::Scheme::kHardHamming, 2.0);
+
+  config.threads = 4;
+  const harq::SimulationPoint multi =
+      harq::Simulator(config).RunPoint(harq::Scheme::kHardHamming, 2.0);
+
+  EXPECT_EQ(single.frames, 2000u);
+  EXPECT_EQ(multi.frames, single.frames);
+  EXPECT_EQ(multi.frame_errors, single.frame_errors);
+  EXPECT_EQ(multi.bit_errors, single.bit_errors);
+  EXPECT_GT(single.frame_errors, 0u);
+  EXPECT_EQ(single.bits, 2000u * 4u);
+}
+
+TEST(SimulatorTest, ErrorRateFallsWithSnr) {
+  harq::SimulationConfig config = SmallConfig();
+  config.threads = 2;
+  config.snr_db = {0.0, 10.0};
+  const std::vector<harq::SimulationPoint> points =
+      harq::Simulator(config).Run();
+
+  ASSERT_EQ(points.size(), 2u);
+  EXPECT_GT(points[0].fer(), points[1].fer());
+  EXPECT_GE(points[0].fer(), points[0].ber());
+}
+
+TEST(SimulatorTest, ChaseIsNotWorseThanHardDecision) {
+  harq::SimulationConfig config = SmallConfig();
+  config.r = 4;
+  config.extended = true;
+  config.chase_d = 4;
+  config.threads = 2;
+  config.max_frames = 4000;
+  config.schemes = {harq::Scheme::kHardHamming, harq::Scheme::kChase1,
+                    harq::Scheme::kChase2, harq::Scheme::kChase3};
+  config.snr_db = {3.0};
+  const std::vector<harq::SimulationPoint> points =
+      harq::Simulator(config).Run();
+
+  ASSERT_EQ(points.size(), 4u);
+  for (std::size_t i = 1; i < points.size(); i++) {
+    EXPECT_LT(points[i].frame_errors, points[0].frame_errors)
+        << harq::SchemeName(points[i].scheme);
+  }
+}
+
+TEST(SimulatorTest, HarqTradesThroughputForReliability) {
+  harq::SimulationConfig config = SmallConfig();
+  config.r = 4;
+  config.extended = true;
+  config.chase_d = 4;
+  config.threads = 2;
+  config.schemes = {harq::Scheme::kChase2, harq::Scheme::kHarqChase};
+  config.snr_db = {0.0};
+  const std::vector<harq::SimulationPoint> points =
+      harq::Simulator(config).Run();
+
+  ASSERT_EQ(points.size(), 2u);
+  const harq::SimulationPoint& chase = points[0];
+  const harq::SimulationPoint& harq_point = points[1];
+  EXPECT_LT(harq_point.fer(), chase.fer());
+  EXPECT_GT(harq_point.channel_symbols, chase.channel_symbols);
+  EXPECT_EQ(chase.channel_symbols, chase.frames * 16u);
+  EXPECT_LE(harq_point.throughput(), 11.0 / 16.0);
+}
+
+TEST(SimulatorTest, IncrementalRedundancyRaisesThroughput) {
+  harq::SimulationConfig config = SmallConfig();
+  config.r = 4;
+  config.chase_d = 4;
+  config.threads = 2;
+  config.schemes = {harq::Scheme::kHarqChase, harq::Scheme::kHarqIr};
+  config.snr_db = {6.0};
+  const std::vector<harq::SimulationPoint> points =
+      harq::Simulator(config).Run();
+
+  ASSERT_EQ(points.size(), 2u);
+  EXPECT_GT(points[1].throughput(), points[0].throughput());
+  EXPECT_LE(points[1].throughput(), 11.0 / 13.0);
+}
+
+TEST(SimulatorTest, EightBitLlrsKeepChaseAndHarqGain) {
+  harq::SimulationConfig config = SmallConfig();
+  config.r = 4;
+  config.extended = true;
+  config.chase_d = 4;
+  config.threads = 2;
+  config.schemes = {harq::Scheme::kChase2, harq::Scheme::kHarqChase};
+  config.snr_db = {1.0};
+  const std::vector<harq::SimulationPoint> exact =
+      harq::Simulator(config).Run();
+
+  config.llr_bits = 8;
+  const std::vector<harq::SimulationPoint> quantized =
+      harq::Simulator(config).Run();
+
+  ASSERT_EQ(quantized.size(), 2u);
+  for (size_t i = 0; i < quantized.size(); i++) {
+    EXPECT_NEAR(quantized[i].fer(), exact[i].fer(), 0.02)
+        << harq::SchemeName(quantized[i].scheme);
+  }
+  EXPECT_LT(quantized[1].fer(), quantized[0].fer());
+}
+
+TEST(SimulatorTest, StopsAtTargetFrameErrors) {
+  harq::SimulationConfig config = SmallConfig();
+  config.threads = 3;
+  config.batch_frames = 16;
+  config.max_frames = 1000000;
+  config.target_frame_errors = 50;
+  const harq::SimulationPoint point =
+      harq::Simulator(config).RunPoint(harq::Scheme::kHardHamming, 0.0);
+
+  EXPECT_GE(point.frame_errors, 50u);
+  EXPECT_LT(point.frames, 10000u);
+}
+
+TEST(SimulatorTest, StopsAtConfidenceTarget) {
+  harq::SimulationConfig config = SmallConfig();
+  config.threads = 1;
+  config.max_frames = 1000000;
+  config.target_relative_ci = 0.2;
+  const harq::SimulationPoint point =
+      harq::Simulator(config).RunPoint(harq::Scheme::kHardHamming, 0.0);
+
+  const double fer = point.fer();
+  const double half_width =
+      1.96 * std::sqrt(fer * (1.0 - fer) / static_cast<double>(point.frames));
+  EXPECT_LT(point.frames, 1000000u);
+  EXPECT_LE(half_width, 0.2 * fer);
+}
+
+TEST(SimulatorTest, WritesCsvCurves) {
+  harq::SimulationConfig config = SmallConfig();
+  config.threads = 1;
+  config.max_frames = 64;
+  config.snr_db = {1.0};
+  std::ostringstream out;
+  harq::WriteCurves(out, harq::Simulator(config).Run());
+
+  const std::string text = out.str();
+  EXPECT_EQ(text.rfind("scheme,snr_db,frames,", 0), 0u);
+  EXPECT_NE(text.find("\nhard,1,64,"), std::string::npos);
+}
+
+TEST(SimulatorTest, RejectsInvalidConfig) {
+  harq::SimulationConfig config = SmallConfig();
+  config.batch_frames = 0;
+  EXPECT_THROW(harq::Simulator{config}, std::invalid_argument);
+
+  config = SmallConfig();
+  config.threads = -1;
+  EXPECT_THROW(harq::Simulator{config}, std::invalid_argument);
+
+  config = SmallConfig();
+  config.chase_d = 0;
+  EXPECT_THROW(harq::Simulator(config).RunPoint(harq::Scheme::kChase2, 1.0),
+               std::invalid_argument);
+}
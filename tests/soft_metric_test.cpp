@@ -0,0 +1,186 @@
+#include "soft_metric.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const harq::SimdLevel kLevels[] = {harq::SimdLevel::kScalar,
+                                   harq::SimdLevel::kSse41,
+                                   harq::SimdLevel::kAvx2};
+
+// Эталон: сумма |LLR| по позициям, где кандидат не совпадает с жёстким решением.
+double ReferenceMetric(const std::vector<double>& llr,
+                       const std::vector<uint8_t>& candidates, size_t row) {
+  double metric = 0.0;
+  for (size_t i = 0; i < llr.size(); i++) {
+    const uint8_t hard = llr[i] >= 0.0 ? 1 : 0;
+    if (hard != candidates[row * llr.size() + i]) {
+      metric += std::abs(llr[i]);
+    }
+  }
+  return metric;
+}
+
+}  // namespace
+
+TEST(SoftMetricTest, ScoresDisagreeingPositions) {
+  const std::vector<double> llr = {1.5, -0.5, 2.0, -3.0, 0.0};
+  // Кандидат 0 совпадает с жёстким решением, кандидат 1 — инвертирован.
+  const std::vector<uint8_t> candidates = {1, 0, 1, 0, 1,
+                                           0, 1, 0, 1, 0};
+  std::vector<double> metrics(2);
+
+  for (auto level : kLevels) {
+    harq::ScoreCandidates(llr, candidates, metrics, level);
+    EXPECT_DOUBLE_EQ(metrics[0], 0.0);
+    EXPECT_DOUBLE_EQ(metrics[1], 7.0);
+  }
+}
+
+TEST(SoftMetricTest, VectorKernelsMatchReference) {
+  std::mt19937 rng(6);
+  std::normal_distribution<double> value(0.0, 4.0);
+  std::uniform_int_distribution<int> bit(0, 1);
+
+  for (size_t n : {7u, 15u, 31u, 64u}) {
+    const size_t rows = 9;
+    std::vector<double> llr(n);
+    std::vector<float> llr_float(n);
+    std::vector<int16_t> llr_fixed(n);
+    for (size_t i = 0; i < n; i++) {
+      llr_fixed[i] = static_cast<int16_t>(std::lround(value(rng) * 64.0));
+      llr[i] = llr_fixed[i];
+      llr_float[i] = static_cast<float>(llr_fixed[i]);
+    }
+    std::vector<uint8_t> candidates(n * rows);
+    for (auto& c : candidates) {
+      c = static_cast<uint8_t>(bit(rng));
+    }
+
+    for (auto level : kLevels) {
+      std::vector<double> metrics(rows);
+      std::vector<float> metrics_float(rows);
+      std::vector<int32_t> metrics_fixed(rows);
+      harq::ScoreCandidates(llr, candidates, metrics, level);
+      harq::ScoreCandidates(llr_float, candidates, metrics_float, level);
+      harq::ScoreCandidates(llr_fixed, candidates, metrics_fixed, level);
+
+      for (size_t row = 0; row < rows; row++) {
+        const double expected = ReferenceMetric(llr, candidates, row);
+        EXPECT_DOUBLE_EQ(metrics[row], expected);
+        EXPECT_FLOAT_EQ(metrics_float[row], static_cast<float>(expected));
+        EXPECT_EQ(metrics_fixed[row], static_cast<int32_t>(expected));
+      }
+    }
+  }
+}
+
+TEST(SoftMetricTest, ThrowsOnBufferMismatch) {
+  const std::vector<double> llr = {1.0, -1.0, 1.0};
+  const std::vector<uint8_t> candidates = {1, 0, 1, 1};
+  std::vector<double> metrics(2);
+  EXPECT_THROW(harq::ScoreCandidates(llr, candidates, metrics),
+               std::invalid_argument);
+}
+
+TEST(SoftMetricTest, AccumulatesScaledLlr) {
+  std::mt19937 rng(10);
+  std::normal_distribution<double> value(0.0, 2.0);
+
+  for (size_t n : {3u, 8u, 17u, 64u}) {
+    std::vector<double> llr(n);
+    std::vector<double> start(n);
+    for (size_t i = 0; i < n; i++) {
+      llr[i] = value(rng);
+      start[i] = value(rng);
+    }
+    std::vector<float> llr_float(llr.begin(), llr.end());
+    std::vector<float> start_float(start.begin(), start.end());
+
+    for (auto level : kLevels) {
+      std::vector<double> acc = start;
+      std::vector<float> acc_float = start_float;
+      harq::AccumulateLlr(acc, llr, 1.5, level);
+      harq::AccumulateLlr(acc_float, llr_float, 1.5f, level);
+      for (size_t i = 0; i < n; i++) {
+        EXPECT_DOUBLE_EQ(acc[i], start[i] + 1.5 * llr[i]);
+        EXPECT_FLOAT_EQ(acc_float[i], start_float[i] + 1.5f * llr_float[i]);
+      }
+    }
+  }
+
+  std::vector<double> acc(4);
+  const std::vector<double> llr(3);
+  EXPECT_THROW(harq::AccumulateLlr(acc, llr), std::invalid_argument);
+}
+
+TEST(SoftMetricTest, Int8KernelsMatchReference) {
+  std::mt19937 rng(14);
+  std::uniform_int_distribution<int> level(-128, 127);
+  std::uniform_int_distribution<int> bit(0, 1);
+
+  for (size_t n : {7u, 16u, 33u, 100u}) {
+    const size_t rows = 5;
+    std::vector<int8_t> llr(n);
+    std::vector<double> llr_double(n);
+    for (size_t i = 0; i < n; i++) {
+      llr[i] = static_cast<int8_t>(level(rng));
+      llr_double[i] = llr[i];
+    }
+    llr[0] = -128;
+    llr_double[0] = -128.0;
+    std::vector<uint8_t> candidates(n * rows);
+    for (auto& c : candidates) {
+      c = static_cast<uint8_t>(bit(rng));
+    }
+
+    for (auto simd : kLevels) {
+      std::vector<int32_t> metrics(rows);
+      harq::ScoreCandidates(llr, candidates, metrics, simd);
+      for (size_t row = 0; row < rows; row++) {
+        EXPECT_EQ(metrics[row], static_cast<int32_t>(ReferenceMetric(
+                                    llr_double, candidates, row)));
+      }
+    }
+  }
+}
+
+TEST(SoftMetricTest, SaturatingAccumulationClampsToLimit) {
+  std::mt19937 rng(15);
+  std::uniform_int_distribution<int> level(-31, 31);
+
+  for (size_t n : {5u, 32u, 70u}) {
+    std::vector<int8_t> start8(n);
+    std::vector<int8_t> llr8(n);
+    for (size_t i = 0; i < n; i++) {
+      start8[i] = static_cast<int8_t>(level(rng));
+      llr8[i] = static_cast<int8_t>(level(rng));
+    }
+    std::vector<int16_t> start16(start8.begin(), start8.end());
+    std::vector<int16_t> llr16(llr8.begin(), llr8.end());
+
+    for (auto simd : kLevels) {
+      std::vector<int8_t> acc8 = start8;
+      std::vector<int16_t> acc16 = start16;
+      harq::AccumulateLlrSaturated(acc8, llr8, 31, simd);
+      harq::AccumulateLlrSaturated(acc16, llr16, 31, simd);
+      for (size_t i = 0; i < n; i++) {
+        const int expected = std::clamp(start8[i] + llr8[i], -31, 31);
+        EXPECT_EQ(acc8[i], expected);
+        EXPECT_EQ(acc16[i], expected);
+      }
+    }
+  }
+
+  std::vector<int8_t> acc(2);
+  const std::vector<int8_t> llr(2);
+  EXPECT_THROW(harq::AccumulateLlrSaturated(acc, llr, 200),
+               std::invalid_argument);
+}
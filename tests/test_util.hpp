@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace harq::test {
+
+// count равновероятных битов 0/1 из генератора теста.
+inline std::vector<uint8_t> RandomBits(std::mt19937& rng, std::size_t count) {
+  std::uniform_int_distribution<int> dist(0, 1);
+  std::vector<uint8_t> bits(count);
+  for (auto& bit : bits) {
+    bit = static_cast<uint8_t>(dist(rng));
+  }
+  return bits;
+}
+
+}  // namespace harq::test